@@ -60,6 +60,12 @@ void Error_Handler(void);
 
 /* Private defines -----------------------------------------------------------*/
 /* USER CODE BEGIN Private defines */
+/* 1: LL-only variant (target 1.Peco10_HWDriver_LL). Clocks, GPIO, TIM1/TIM2 and SPI1 are set
+ * up at register level by Ll_Init_System and no HAL function is reachable, so the linker
+ * drops every HAL object. 0: CubeMX HAL initialisation */
+#ifndef PECO10_LL_BUILD
+#define PECO10_LL_BUILD 0U
+#endif
 
 /* USER CODE END Private defines */
 
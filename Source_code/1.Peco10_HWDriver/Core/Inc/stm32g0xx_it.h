@@ -51,8 +51,15 @@ void HardFault_Handler(void);
 void SVC_Handler(void);
 void PendSV_Handler(void);
 void SysTick_Handler(void);
+void TIM1_BRK_UP_TRG_COM_IRQHandler(void);
+void TIM2_IRQHandler(void);
 void SPI1_IRQHandler(void);
 /* USER CODE BEGIN EFP */
+void DMA1_Channel1_IRQHandler(void);
+void DMA1_Channel2_3_IRQHandler(void);
+void USART2_IRQHandler(void);
+void RTC_TAMP_IRQHandler(void);
+void EXTI2_3_IRQHandler(void);
 
 /* USER CODE END EFP */
 
@@ -25,15 +25,54 @@
 #include "Lcd_segment.h"
 #include "Keypad.h"
 #include "Standard.h"
+#include "Timebase.h"
+#include "Serial_slave.h"
+#include "Settings.h"
+#include "Backlight.h"
+#include "Ll_init.h"
+#include "Rtc.h"
+#include "Event_bus.h"
+#include "Stack_monitor.h"
+#include "Benchmark.h"
+#include "Led_bcm.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
 /* USER CODE BEGIN PTD */
+/* Cold start: the segment LCD, keypad and bus run while the HD44780 powers up */
+typedef enum
+{
+  BOOT_CHARACTER_LCD_INIT = 0U,     /* HD44780 power-on sequence in progress */
+  BOOT_RUNNING                      /* Both displays ready */
+} Boot_State_Type;
+
+/* TRACE_ID_BOOT data */
+typedef enum
+{
+  BOOT_MILESTONE_FIRST_FRAME = 0U,
+  BOOT_MILESTONE_CHARACTER_READY
+} Boot_Milestone_Type;
 
 /* USER CODE END PTD */
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
+/* Segment LCD driver put in power saving mode after this long without key press or bus frame */
+#define SEGMENT_IDLE_TIMEOUT_US     (300000000U)
+/* Standby after this long without key press or bus frame: backlight off, Stop between seconds.
+ * Longer than BACKLIGHT_IDLE_TIMEOUT_US plus the dim fade so the backlight is settled */
+#define STANDBY_IDLE_TIMEOUT_US     (60000000U)
+
+/* Segment LCD lines of the clock, HH.MM.SS and DD.MM.YY on cols 2 to 7 */
+#define CLOCK_TIME_LINE             (0U)
+#define CLOCK_DATE_LINE             (1U)
+#define CLOCK_FIRST_COL             (2U)
+#define CLOCK_NOT_SHOWN             (0xFFFFFFFFU)
+
+/* Main loop sleep between two keypad and switch scans, events wake it earlier */
+#define MAIN_POLL_PERIOD_US         (10000U)
+/* Shorter while the HD44780 power-on sequence runs, its steps are polled */
+#define MAIN_BOOT_POLL_PERIOD_US    (1000U)
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -53,6 +92,24 @@ uint8_t Keypad_string[]="Cur Button:";
 uint8_t data0[]="   0,0.0";
 uint8_t data1[]="0,00,00";
 uint8_t data2[]="1,2.3,456";
+
+/* Boot timings in us from Timebase_Init, read them with the debugger or from the trace */
+volatile uint32_t BootFirstFrameUs = 0U;
+volatile uint32_t BootCharacterReadyUs = 0U;
+/* Deepest main stack use in bytes, refreshed every RTC second, and set once the stack guard was reached */
+volatile uint32_t StackHighWaterBytes = 0U;
+volatile uint8_t StackGuardHit = 0U;
+
+/* Application state shared by the event handlers */
+static Boot_State_Type BootState = BOOT_CHARACTER_LCD_INIT;
+static uint32_t SegmentIdleDeadline;
+static uint32_t StandbyDeadline;
+static uint8_t Standby = 0U;
+static uint8_t Address = 0U;
+static uint32_t ShownTime = CLOCK_NOT_SHOWN;
+static uint32_t ShownDate = CLOCK_NOT_SHOWN;
+/* F1 + F4 were held when the character LCD became ready */
+static uint8_t BenchmarkPending = 0U;
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -62,12 +119,182 @@ static void MX_SPI1_Init(void);
 static void MX_TIM1_Init(void);
 static void MX_TIM2_Init(void);
 /* USER CODE BEGIN PFP */
-
+#if (PECO10_LL_BUILD == 1U)
+/* Generated above and never called, Ll_Init_System replaces them */
+static void MX_GPIO_Init(void) __attribute__((unused));
+static void MX_SPI1_Init(void) __attribute__((unused));
+static void MX_TIM1_Init(void) __attribute__((unused));
+static void MX_TIM2_Init(void) __attribute__((unused));
+#endif
+static void Clock_Show(uint8_t line, uint32_t Bcd, uint32_t* pShown);
+static void App_Activity(void);
+static void App_Show_Address(void);
+static void App_On_Key(const Event_Type* pEvent);
+static void App_On_Switch(const Event_Type* pEvent);
+static void App_On_Second(const Event_Type* pEvent);
+static void App_On_Serial_Received(const Event_Type* pEvent);
+static void App_On_Serial_Frame(const Event_Type* pEvent);
+static void App_Loop_Work(void);
+static void App_Loop_Pass(void);
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
+/**
+  * @brief  Draw 6 BCD digits as XX.XX.XX on a segment line, only the digits that changed
+  * @param  line: segment LCD line
+  * @param  Bcd: 0x00XXXXXX
+  * @param  pShown: value on the line, CLOCK_NOT_SHOWN to draw everything
+  * @retval None
+  */
+static void Clock_Show(uint8_t line, uint32_t Bcd, uint32_t* pShown)
+{
+  uint8_t k;
+  uint8_t Digit;
+
+  if(*pShown == CLOCK_NOT_SHOWN)
+  {
+    Lcd_Segment_Put_Data((uint8_t*)" ", line);
+    Lcd_Segment_Put_Char(line, CLOCK_FIRST_COL + 1U, '.');
+    Lcd_Segment_Put_Char(line, CLOCK_FIRST_COL + 3U, '.');
+  }
+  for(k = 0U; k < 6U; k++)
+  {
+    Digit = (uint8_t)((Bcd >> (20U - (4U * k))) & 0x0FU);
+    if((*pShown == CLOCK_NOT_SHOWN) || (((*pShown >> (20U - (4U * k))) & 0x0FU) != Digit))
+    {
+      Lcd_Segment_Put_Char(line, CLOCK_FIRST_COL + k, (uint8_t)('0' + Digit));
+    }
+  }
+  *pShown = Bcd;
+}
+
+/**
+  * @brief  Restart the segment idle, standby and backlight timeouts after a key press or a bus frame
+  * @retval None
+  */
+static void App_Activity(void)
+{
+  SegmentIdleDeadline = Timebase_Deadline_After(SEGMENT_IDLE_TIMEOUT_US);
+  StandbyDeadline = Timebase_Deadline_After(STANDBY_IDLE_TIMEOUT_US);
+  if(Standby != 0U)
+  {
+    /* Standby switched the backlight off, it was not dimmed */
+    Standby = 0U;
+    Backlight_Fade_To(Backlight_Get_Level(), 0U);
+  }
+  Backlight_Activity();
+}
+
+/**
+  * @brief  Show the bus address on the character LCD
+  * @retval None
+  */
+static void App_Show_Address(void)
+{
+  uint8_t pDevide_Address[10];
+  uint8_t pClear_data[10]="  ";
+
+  DecToString(pDevide_Address,Address);
+  Lcd_Put_String(1,strlen((char*)Add_string) + 1,(uint8_t*)pClear_data);
+  Lcd_Put_String(1,strlen((char*)Add_string) + 1,(uint8_t*)pDevide_Address);
+}
+
+/**
+  * @brief  EVENT_KEY_PRESSED: wake the segment LCD and show the key name
+  * @param  pEvent: key name, first char | second char << 8
+  * @retval None
+  */
+static void App_On_Key(const Event_Type* pEvent)
+{
+  uint8_t key[3];
+  uint8_t pClear_data[10]="  ";
+
+  App_Activity();
+  Lcd_Segment_Resume();
+  if(BootState == BOOT_RUNNING)
+  {
+    key[0] = (uint8_t)pEvent->Data;
+    key[1] = (uint8_t)(pEvent->Data >> 8);
+    key[2] = 0U;
+    Lcd_Put_String(0,strlen((char*)Keypad_string) + 1,(uint8_t*)pClear_data);
+    Lcd_Set_Cursor(0,strlen((char*)Keypad_string) + 1);
+    Lcd_Put_String(0,strlen((char*)Keypad_string) + 1,(uint8_t*)key);
+  }
+}
+
+/**
+  * @brief  EVENT_SWITCH_CHANGED: new bus address
+  * @param  pEvent: switch value
+  * @retval None
+  */
+static void App_On_Switch(const Event_Type* pEvent)
+{
+  Address = (uint8_t)pEvent->Data;
+  Serial_Slave_Set_Address(Address);
+  /* Shown once the HD44780 is ready otherwise */
+  if(BootState == BOOT_RUNNING)
+  {
+    App_Show_Address();
+  }
+}
+
+/**
+  * @brief  EVENT_RTC_SECOND: clock on the segment LCD, until the bus master takes over the display
+  * @param  pEvent: unused
+  * @retval None
+  */
+static void App_On_Second(const Event_Type* pEvent)
+{
+  uint32_t Date;
+  uint32_t Time;
+
+  (void)pEvent;
+  StackHighWaterBytes = Stack_Monitor_Get_High_Water();
+  if(Stack_Monitor_Check() != E_OK)
+  {
+    StackGuardHit = 1U;
+  }
+  if(Serial_Slave_Get_Frame_Count() == 0U)
+  {
+    Rtc_Get_Date_Time(&Date, &Time);
+    Clock_Show(CLOCK_TIME_LINE, Time, &ShownTime);
+    /* 0xYYYYMMDD shown as DD.MM.YY */
+    Clock_Show(CLOCK_DATE_LINE, ((Date & 0xFFU) << 16) | (Date & 0xFF00U) | ((Date >> 16) & 0xFFU), &ShownDate);
+  }
+  /* Full refresh once per second while awake, in case the driver lost its RAM */
+  if(Standby == 0U)
+  {
+    Lcd_Segment_Display_App();
+  }
+}
+
+/**
+  * @brief  EVENT_SERIAL_RECEIVED: apply the frames, they stay queued in the DMA ring during the cold start
+  * @param  pEvent: unused
+  * @retval None
+  */
+static void App_On_Serial_Received(const Event_Type* pEvent)
+{
+  (void)pEvent;
+  if(BootState == BOOT_RUNNING)
+  {
+    Serial_Slave_Process();
+  }
+}
 
+/**
+  * @brief  EVENT_SERIAL_FRAME: the bus master is active, wake the segment LCD
+  * @param  pEvent: command, unused
+  * @retval None
+  */
+static void App_On_Serial_Frame(const Event_Type* pEvent)
+{
+  (void)pEvent;
+  App_Activity();
+  /* No longer idle, light the segment LCD blanked by the idle timeout */
+  Lcd_Segment_Resume();
+}
 /* USER CODE END 0 */
 
 /**
@@ -77,7 +304,12 @@ static void MX_TIM2_Init(void);
 int main(void)
 {
   /* USER CODE BEGIN 1 */
-
+  /* Before any deep call so the high-water mark covers the whole run */
+  Stack_Monitor_Init();
+#if (PECO10_LL_BUILD == 1U)
+  /* Register level replacement of everything CubeMX generates down to USER CODE 2 */
+  Ll_Init_System();
+#else
   /* USER CODE END 1 */
 
   /* MCU Configuration--------------------------------------------------------*/
@@ -102,20 +334,15 @@ int main(void)
   MX_TIM1_Init();
   MX_TIM2_Init();
   /* USER CODE BEGIN 2 */
-  uint8_t num[10];
-  uint32_t i=0;
-  
-  uint8_t key[2];
-  Keypad_Button_Type Keypad_status = BUTTON_UNKNOWN;
+#endif
   
-  uint8_t pDevide_Address[10];
-  uint8_t pClear_data[10]="  ";
-  uint8_t add,temp;
-  temp = 0xff;
   
-  HAL_TIM_Base_Start(&htim2);
-  HAL_TIM_PWM_Start(&htim1,TIM_CHANNEL_1);
-  Lcd_Init_4bits_Mode();
+  Timebase_Init();
+  Trace_Init();
+  Standard_Init();
+  Event_Init();
+  /* Start the 40 ms HD44780 power-on wait first, the rest of the boot runs inside it */
+  Lcd_Init_4bits_Mode_Start();
   Lcd_Segment_Init();
   
   //Lcd_Segment_Put_Data(data0,0);
@@ -123,8 +350,19 @@ int main(void)
   //Lcd_Segment_Put_Data(data2,2);
   Lcd_Segment_Put_Indicator(0xf8);
   Lcd_Segment_Display_App();
-  Lcd_Put_String(0,0,(uint8_t*)Keypad_string);
-  Lcd_Put_String(1,0,(uint8_t*)Add_string);
+  BootFirstFrameUs = Timebase_Now();
+  TRACE_INSTANT(TRACE_ID_BOOT, BOOT_MILESTONE_FIRST_FRAME);
+  
+  Settings_Init();
+  Rtc_Init();
+  Backlight_Init();
+  Serial_Slave_Init();
+  App_Activity();
+  (void)Event_Subscribe(EVENT_KEY_PRESSED, App_On_Key);
+  (void)Event_Subscribe(EVENT_SWITCH_CHANGED, App_On_Switch);
+  (void)Event_Subscribe(EVENT_RTC_SECOND, App_On_Second);
+  (void)Event_Subscribe(EVENT_SERIAL_RECEIVED, App_On_Serial_Received);
+  (void)Event_Subscribe(EVENT_SERIAL_FRAME, App_On_Serial_Frame);
   //Lcd_Put_String(0,2,(uint8_t*)data);
   /* USER CODE END 2 */
 
@@ -135,37 +373,7 @@ int main(void)
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
-    /*Lcd segment test*/
-    DecToString(num,i);
-    Lcd_Segment_Put_Data(num,0);
-    Lcd_Segment_Put_Data(num,1);
-    Lcd_Segment_Put_Data(num,2);
-    Lcd_Segment_Display_App(); 
-
-    /*Keypad scaning test*/
-
-    Keypad_status = Keypad_Scan(key);
-    if(Keypad_status == KEYPAD_PUSHED)
-    {
-        Lcd_Put_String(0,strlen((char*)Keypad_string) + 1,(uint8_t*)pClear_data);
-        Lcd_Set_Cursor(0,strlen((char*)Keypad_string) + 1);
-        Lcd_Put_String(0,strlen((char*)Keypad_string) + 1,(uint8_t*)key);
-    }
-    
-    /*Switch test*/
-    add = Config_Switch_Get_Value();
-    if(temp != add)
-    {
-        DecToString(pDevide_Address,add);
-        temp = add;
-        Lcd_Put_String(1,strlen((char*)Add_string) + 1,(uint8_t*)pClear_data);
-        Lcd_Put_String(1,strlen((char*)Add_string) + 1,(uint8_t*)pDevide_Address);
-    }
-      
-    mdelay(1);
-    i++;
-    if(i == 9999999)
-        i=0;
+    App_Loop_Pass();
   }
   /* USER CODE END 3 */
 }
@@ -271,7 +479,7 @@ static void MX_TIM1_Init(void)
 
   /* USER CODE END TIM1_Init 1 */
   htim1.Instance = TIM1;
-  htim1.Init.Prescaler = 15;
+  htim1.Init.Prescaler = TIMEBASE_PRESCALER(SystemCoreClock);
   htim1.Init.CounterMode = TIM_COUNTERMODE_UP;
   htim1.Init.Period = 999;
   htim1.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
@@ -351,7 +559,7 @@ static void MX_TIM2_Init(void)
 
   /* USER CODE END TIM2_Init 1 */
   htim2.Instance = TIM2;
-  htim2.Init.Prescaler = 15;
+  htim2.Init.Prescaler = TIMEBASE_PRESCALER(SystemCoreClock);
   htim2.Init.CounterMode = TIM_COUNTERMODE_UP;
   htim2.Init.Period = 4294967295;
   htim2.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
@@ -441,6 +649,109 @@ static void MX_GPIO_Init(void)
 }
 
 /* USER CODE BEGIN 4 */
+/**
+  * @brief  Work of one main loop pass: boot step, scans, events, displays
+  * @retval None
+  */
+static void App_Loop_Work(void)
+{
+  /* Run the display and keypad traffic at 64 MHz */
+  Timebase_Set_Clock_Mode(TIMEBASE_CLOCK_FAST);
+  
+  /*Cold start, next HD44780 power-on step once its wait has elapsed*/
+  if(BootState == BOOT_CHARACTER_LCD_INIT)
+  {
+    if(Lcd_Init_4bits_Mode_Poll() == LCD_INIT_DONE)
+    {
+      BootCharacterReadyUs = Timebase_Now();
+      TRACE_INSTANT(TRACE_ID_BOOT, BOOT_MILESTONE_CHARACTER_READY);
+      Lcd_Put_String(0,0,(uint8_t*)Keypad_string);
+      Lcd_Put_String(1,0,(uint8_t*)Add_string);
+      BootState = BOOT_RUNNING;
+      App_Show_Address();
+      /* Diagnostic mode, the keypad is read once the HD44780 can show the results */
+      BenchmarkPending = Benchmark_Is_Requested();
+      /* Frames queued during the cold start */
+      Serial_Slave_Process();
+    }
+  }
+
+  /* Hardware without interrupt, published only on change */
+  Keypad_Task();
+  Config_Switch_Task();
+
+  /* Work happens in the subscribers, only for what changed */
+  (void)Event_Dispatch();
+
+  /* Only the frames that changed */
+  Lcd_Segment_Flush();
+  Lcd_Segment_Blink_Task();
+  Lcd_Segment_Marquee_Task();
+  if(BootState == BOOT_RUNNING)
+  {
+    Lcd_Marquee_Task();
+  }
+
+  /*Blank the segment LCD when neither the keypad nor the bus master has been active for a while*/
+  if(Timebase_Expired(SegmentIdleDeadline) != 0U)
+  {
+    Lcd_Segment_Power_Save();
+  }
+  
+  /*Dim the backlight once the keypad has been idle for a while*/
+  Backlight_Task();
+
+  /* Latch the 74HC595 outputs changed during this pass in one shift-out */
+  (void)IC_74hc595_Flush();
+}
+
+/**
+  * @brief  One pass of the main loop: its work, then sleep until the next scan
+  * @retval None
+  */
+static void App_Loop_Pass(void)
+{
+  App_Loop_Work();
+  if(BenchmarkPending != 0U)
+  {
+    /* Times the drivers and App_Loop_Work until X is pushed, then back to the normal screen */
+    BenchmarkPending = 0U;
+    Benchmark_Run(App_Loop_Work);
+    Lcd_Clear();
+    Lcd_Put_String(0,0,(uint8_t*)Keypad_string);
+    Lcd_Put_String(1,0,(uint8_t*)Add_string);
+    App_Show_Address();
+    App_Activity();
+  }
+  
+  /* Idle at 16 MHz with the PLL stopped */
+  Timebase_Set_Clock_Mode(TIMEBASE_CLOCK_SLOW);
+  if((BootState == BOOT_RUNNING) && ((Standby != 0U) || (Timebase_Expired(StandbyDeadline) != 0U)))
+  {
+    if(Standby == 0U)
+    {
+      /* TIM1 stops in Stop mode, leave the PWM output low: CCR1 0 applies on the next 1 ms period */
+      Standby = 1U;
+      Backlight_Fade_To(0U, 0U);
+      mdelay(2);
+    }
+    /* Sleep until the next RTC second or the start of a bus frame, a key must be held until then */
+    Serial_Slave_Wakeup_Enable(1U);
+    /* SPI1 and the DMA stop too, the clock of this second must be out with SCE released */
+    Lcd_Segment_Wait_Idle();
+    /* TIM2 stops too, dimmed LEDs would hold whatever bit plane was shown */
+    Led_Bcm_Suspend();
+    Rtc_Stop_Until_Wakeup();
+    Led_Bcm_Resume();
+    Serial_Slave_Wakeup_Enable(0U);
+  }
+  else
+  {
+    /* Until the next scan, an event published from an interrupt ends the sleep early */
+    Event_Wait_Until(Timebase_Deadline_After((BootState == BOOT_RUNNING) ? MAIN_POLL_PERIOD_US
+                                                                         : MAIN_BOOT_POLL_PERIOD_US));
+  }
+}
 
 /* USER CODE END 4 */
 
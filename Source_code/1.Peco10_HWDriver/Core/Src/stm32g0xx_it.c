@@ -22,6 +22,11 @@
 #include "stm32g0xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "Serial_slave.h"
+#include "Backlight.h"
+#include "Rtc.h"
+#include "Lcd_segment.h"
+#include "Led_bcm.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -56,6 +61,8 @@
 
 /* External variables --------------------------------------------------------*/
 extern SPI_HandleTypeDef hspi1;
+extern TIM_HandleTypeDef htim1;
+extern TIM_HandleTypeDef htim2;
 /* USER CODE BEGIN EV */
 
 /* USER CODE END EV */
@@ -125,11 +132,11 @@ void PendSV_Handler(void)
 void SysTick_Handler(void)
 {
   /* USER CODE BEGIN SysTick_IRQn 0 */
-
+#if (PECO10_LL_BUILD == 0U)
   /* USER CODE END SysTick_IRQn 0 */
   HAL_IncTick();
   /* USER CODE BEGIN SysTick_IRQn 1 */
-
+#endif
   /* USER CODE END SysTick_IRQn 1 */
 }
 
@@ -140,20 +147,100 @@ void SysTick_Handler(void)
 /* please refer to the startup file (startup_stm32g0xx.s).                    */
 /******************************************************************************/
 
+/**
+  * @brief This function handles TIM1 break, update, trigger and commutation interrupts.
+  */
+void TIM1_BRK_UP_TRG_COM_IRQHandler(void)
+{
+  /* USER CODE BEGIN TIM1_BRK_UP_TRG_COM_IRQn 0 */
+#if (PECO10_LL_BUILD == 1U)
+  /* Only the update interrupt is enabled, it carries the backlight fade */
+  if((TIM1->SR & TIM_SR_UIF) != 0U)
+  {
+    TIM1->SR = ~TIM_SR_UIF;
+    Backlight_Timer_IRQHandler();
+  }
+#else
+  /* USER CODE END TIM1_BRK_UP_TRG_COM_IRQn 0 */
+  HAL_TIM_IRQHandler(&htim1);
+  /* USER CODE BEGIN TIM1_BRK_UP_TRG_COM_IRQn 1 */
+#endif
+  /* USER CODE END TIM1_BRK_UP_TRG_COM_IRQn 1 */
+}
+
+/**
+  * @brief This function handles TIM2 global interrupt.
+  */
+void TIM2_IRQHandler(void)
+{
+  /* USER CODE BEGIN TIM2_IRQn 0 */
+  /* CC2 is the BCM bit plane timer, handled and cleared before the HAL sees it */
+  Led_Bcm_Timer_IRQHandler();
+#if (PECO10_LL_BUILD == 1U)
+  /* CC1 only wakes the core out of the Timebase waits */
+  TIM2->SR = ~TIM_SR_CC1IF;
+#else
+  /* USER CODE END TIM2_IRQn 0 */
+  HAL_TIM_IRQHandler(&htim2);
+  /* USER CODE BEGIN TIM2_IRQn 1 */
+#endif
+  /* USER CODE END TIM2_IRQn 1 */
+}
+
 /**
   * @brief This function handles SPI1 global interrupt.
   */
 void SPI1_IRQHandler(void)
 {
   /* USER CODE BEGIN SPI1_IRQn 0 */
-
+#if (PECO10_LL_BUILD == 0U)
   /* USER CODE END SPI1_IRQn 0 */
   HAL_SPI_IRQHandler(&hspi1);
   /* USER CODE BEGIN SPI1_IRQn 1 */
-
+#endif
   /* USER CODE END SPI1_IRQn 1 */
 }
 
 /* USER CODE BEGIN 1 */
+/**
+  * @brief This function handles DMA1 channel 1 interrupt (serial slave reception).
+  */
+void DMA1_Channel1_IRQHandler(void)
+{
+  Serial_Slave_Dma_IRQHandler();
+}
 
+/**
+  * @brief This function handles DMA1 channel 2 and 3 interrupt (segment LCD frames).
+  */
+void DMA1_Channel2_3_IRQHandler(void)
+{
+#if (LCD_SEGMENT_SPI_HAL == 0U)
+  Lcd_Segment_Dma_IRQHandler();
+#endif
+}
+
+/**
+  * @brief This function handles USART2 global interrupt (serial slave idle line).
+  */
+void USART2_IRQHandler(void)
+{
+  Serial_Slave_Usart_IRQHandler();
+}
+
+/**
+  * @brief This function handles RTC wake-up interrupt through EXTI line 19.
+  */
+void RTC_TAMP_IRQHandler(void)
+{
+  Rtc_IRQHandler();
+}
+
+/**
+  * @brief This function handles EXTI line 3 interrupt (serial slave wake-up from Stop).
+  */
+void EXTI2_3_IRQHandler(void)
+{
+  Serial_Slave_Wakeup_IRQHandler();
+}
 /* USER CODE END 1 */
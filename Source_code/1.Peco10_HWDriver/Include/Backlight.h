@@ -0,0 +1,128 @@
+#ifndef BACKLIGHT_H
+#define BACKLIGHT_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+
+#include "Standard.h"
+#include "main.h"
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+/* Backlight PWM on TIM1 CH1 (PA8), 1 kHz, CCR1 range 0..BACKLIGHT_PWM_PERIOD */
+#define BACKLIGHT_TIMER                         (&htim1)
+#define BACKLIGHT_TIM                           TIM1
+#define BACKLIGHT_CHANNEL                       TIM_CHANNEL_1
+#define BACKLIGHT_PWM_PERIOD                    (999U)
+
+/* Perceived brightness in percent, mapped to the duty through a gamma 2.2 table */
+#define BACKLIGHT_LEVEL_MAX                     (100U)
+/* Level used until one is stored, same duty as the former fixed 900/999 pulse */
+#define BACKLIGHT_DEFAULT_LEVEL                 (95U)
+/* Level after BACKLIGHT_IDLE_TIMEOUT_US without key press */
+#define BACKLIGHT_DIM_LEVEL                     (20U)
+#define BACKLIGHT_IDLE_TIMEOUT_US               (30000000U)
+
+/* Fade durations in PWM periods (ms) */
+#define BACKLIGHT_FADE_MS                       (300U)
+#define BACKLIGHT_DIM_FADE_MS                   (2000U)
+/*==================================================================================================
+                                           CONSTANTS
+==================================================================================================*/
+extern TIM_HandleTypeDef htim1;
+/*==================================================================================================
+*                                              ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+/**
+ * @brief  This function uses to restore the stored backlight level and start the PWM
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ *
+ * @note Settings_Init must have been called. Subscribes to EVENT_KEY_PRESSED for the idle timeout
+ */
+void Backlight_Init(void);
+
+/**
+ * @brief  This function uses to change the user backlight level with a fade
+ *
+ * @param[in]  Level  : perceived brightness [0-100]
+ *
+ * @retval void
+ *
+ * @note The level is stored in the settings log
+ */
+void Backlight_Set_Level(uint8_t Level);
+
+/**
+ * @brief  This function uses to get the user backlight level
+ *
+ * @param[in]  None
+ *
+ * @retval uint8_t
+ */
+uint8_t Backlight_Get_Level(void);
+
+/**
+ * @brief  This function uses to fade the backlight to a level
+ *
+ * @param[in]  Level       : perceived brightness [0-100]
+ *             DurationMs  : fade duration, 0 for an immediate change
+ *
+ * @retval void
+ *
+ * @note The fade runs from the TIM1 update interrupt, the call returns at once
+ */
+void Backlight_Fade_To(uint8_t Level, uint16_t DurationMs);
+
+/**
+ * @brief  This function uses to signal user activity (key press)
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ *
+ * @note A dimmed backlight comes back to the user level immediately
+ */
+void Backlight_Activity(void);
+
+/**
+ * @brief  This function uses to dim the backlight after the idle timeout
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ *
+ * @note Should be called in the main loop
+ */
+void Backlight_Task(void);
+
+/**
+ * @brief  This function uses to run one fade step on the TIM1 update interrupt
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ *
+ * @note Called from HAL_TIM_PeriodElapsedCallback, or straight from the TIM1 handler in the LL build
+ */
+void Backlight_Timer_IRQHandler(void);
+
+#endif /* BACKLIGHT_H */
@@ -0,0 +1,71 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+
+#include "Standard.h"
+#include "Keypad.h"
+#include "main.h"
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+/* Chord held at power-up to enter the diagnostic mode: F1 + F4 */
+#define BENCHMARK_CHORD                         (KEYPAD_KEY_BIT(0U, 3U) | KEYPAD_KEY_BIT(3U, 3U))
+
+/* Keys of the result pages: X leaves, C measures again, any other key shows the next page */
+#define BENCHMARK_KEY_EXIT                      KEYPAD_KEY_BIT(3U, 2U)
+#define BENCHMARK_KEY_RERUN                     KEYPAD_KEY_BIT(3U, 1U)
+
+/* Runs of each path, the page shows their average and maximum */
+#define BENCHMARK_RUNS                          (16U)
+
+/* Keypad poll period on the result pages */
+#define BENCHMARK_KEY_POLL_MS                   (20U)
+/*==================================================================================================
+                                           CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                              ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/* One pass of the main loop without its sleep, timed as the idle superloop iteration */
+typedef void (*Benchmark_Pass_Type)(void);
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+/**
+ * @brief  This function uses to check whether the diagnostic mode chord is held
+ *
+ * @param[in]  None
+ *
+ * @retval uint8_t 1 when exactly BENCHMARK_CHORD is pushed
+ */
+uint8_t Benchmark_Is_Requested(void);
+
+/**
+ * @brief  This function uses to time the key paths with TIM2 and page the results on the character LCD
+ *
+ * @param[in]  pIdlePass  : main loop pass without its sleep
+ *
+ * @retval void
+ *
+ * @note Blocks until X is pushed, the caller redraws the character LCD afterwards. Timed paths:
+ *       74HC595 chain update, Lcd_Put_Char, Lcd_Segment_Display_App up to the end of its SPI
+ *       transfer, Keypad_Scan and pIdlePass. The HD44780 must be ready
+ */
+void Benchmark_Run(Benchmark_Pass_Type pIdlePass);
+
+#endif /* BENCHMARK_H */
@@ -0,0 +1,75 @@
+#ifndef DISPLAY_DELTA_H
+#define DISPLAY_DELTA_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+
+#include "Standard.h"
+#include "main.h"
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+/*
+ * Delta batch layout, carried as the payload of SERIAL_CMD_DISPLAY_DELTA:
+ *  [0..N-5]    Records, back to back
+ *  [N-4..N-1]  CRC-32 of the records, little endian
+ *
+ * CRC-32 as computed by the STM32G0 CRC unit in its reset configuration
+ * (polynomial 0x04C11DB7, init 0xFFFFFFFF, no reflection, no final xor, byte writes),
+ * i.e. CRC-32/MPEG-2. Tools/display_delta.py is the host reference.
+ *
+ * The whole batch is checked before the first record is applied, so a frame
+ * either updates every display or none of them.
+ */
+#define DISPLAY_DELTA_CRC_SIZE                  (4U)
+
+/* Raw segment RAM patch: offset, count, count bytes for LcdDisplayRam */
+#define DISPLAY_DELTA_RAM_PATCH                 (0x01U)
+/* Number on a segment line: line, format, value (int32_t little endian) */
+#define DISPLAY_DELTA_NUMBER                    (0x02U)
+/* Segment indicator bits: indicator byte for Lcd_Segment_Put_Indicator */
+#define DISPLAY_DELTA_INDICATOR                 (0x03U)
+/* Character LCD cells: line, column, count, count characters */
+#define DISPLAY_DELTA_CHARACTER_CELLS           (0x04U)
+
+/* Number record format byte: bits 0-2 digits after the separator, bit 7 comma instead of dot */
+#define DISPLAY_DELTA_NUMBER_DECIMAL_MASK       (0x07U)
+#define DISPLAY_DELTA_NUMBER_COMMA              (0x80U)
+/*==================================================================================================
+                                           CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                              ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+/**
+ * @brief  This function uses to check and apply one delta batch read in place from a ring buffer
+ *
+ * @param[in]  pRing   : ring buffer base
+ *             Mask    : ring size - 1 (power of 2)
+ *             Start   : index of the first record byte in the ring
+ *             Length  : batch length, records and CRC
+ *
+ * @retval Std_Return_Type
+ *
+ * @note E_NOT_OK on a CRC mismatch or a malformed record, nothing is applied in that case
+ */
+Std_Return_Type Display_Delta_Apply(const uint8_t* pRing, uint16_t Mask, uint16_t Start, uint16_t Length);
+
+#endif /* DISPLAY_DELTA_H */
@@ -0,0 +1,134 @@
+#ifndef EVENT_BUS_H
+#define EVENT_BUS_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+
+#include "Standard.h"
+#include "main.h"
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+/* Events waiting for Event_Dispatch, power of 2 */
+#define EVENT_QUEUE_SIZE                        (16U)
+/* Handlers per event */
+#define EVENT_MAX_SUBSCRIBERS                   (4U)
+/* Events without data, kept as a pending flag instead of a queue entry: never dropped on a full
+ * queue, repeats before Event_Dispatch are delivered once */
+#define EVENT_LEVEL_MASK                        ((1UL << EVENT_RTC_SECOND) | (1UL << EVENT_SERIAL_RECEIVED))
+/*==================================================================================================
+                                           CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                              ENUMS
+==================================================================================================*/
+/**
+ * @brief Event_Id_Type, one per kind of change, Data meaning in the comment
+ */
+typedef enum
+{
+    EVENT_KEY_PRESSED           = 0U,   /* Keypad_Task: key name, first char | second char << 8 */
+    EVENT_SWITCH_CHANGED        = 1U,   /* Config_Switch_Task: switch value */
+    EVENT_RTC_SECOND            = 2U,   /* Rtc_IRQHandler: none */
+    EVENT_SERIAL_RECEIVED       = 3U,   /* Serial_Slave_Usart_IRQHandler: none, a frame waits for Serial_Slave_Process */
+    EVENT_SERIAL_FRAME          = 4U,   /* Serial_Slave_Process: command of a frame applied */
+    EVENT_COUNT
+} Event_Id_Type;
+
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief Event_Type, one queued event
+ */
+typedef struct
+{
+    Event_Id_Type Id;
+    uint32_t Data;
+} Event_Type;
+
+/* Subscriber, called from Event_Dispatch in thread context */
+typedef void (*Event_Handler_Type)(const Event_Type* pEvent);
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+/**
+ * @brief  This function uses to create the wake semaphore of Event_Wait_Until
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ *
+ * @note Only needed with threads (OS_PORT_POSIX), before they start
+ */
+void Event_Init(void);
+
+/**
+ * @brief  This function uses to register a handler for one event
+ *
+ * @param[in]  Id       : event
+ *             Handler  : called for each event of this kind, in subscription order
+ *
+ * @retval Std_Return_Type
+ *
+ * @note E_NOT_OK when EVENT_MAX_SUBSCRIBERS handlers are already registered
+ */
+Std_Return_Type Event_Subscribe(Event_Id_Type Id, Event_Handler_Type Handler);
+
+/**
+ * @brief  This function uses to queue an event
+ *
+ * @param[in]  Id    : event
+ *             Data  : event data
+ *
+ * @retval Std_Return_Type
+ *
+ * @note Safe from thread and interrupt context, any task may publish.
+ *       E_NOT_OK and the event is dropped when the queue is full, except EVENT_LEVEL_MASK events
+ */
+Std_Return_Type Event_Publish(Event_Id_Type Id, uint32_t Data);
+
+/**
+ * @brief  This function uses to call the subscribers of every queued event
+ *
+ * @param[in]  None
+ *
+ * @retval uint8_t : number of events dispatched
+ *
+ * @note Should be called in the main loop, or by a single thread.
+ *       Events published by a handler are dispatched in the same call, pending
+ *       EVENT_LEVEL_MASK events first (Data 0)
+ */
+uint8_t Event_Dispatch(void);
+
+/**
+ * @brief  This function uses to sleep until an event is published or a deadline is reached
+ *
+ * @param[in]  Deadline  : deadline returned by Timebase_Deadline_After
+ *
+ * @retval void
+ *
+ * @note Sleeps in WFI on bare metal, blocks on a semaphore with threads
+ */
+void Event_Wait_Until(uint32_t Deadline);
+
+/**
+ * @brief  This function uses to get the number of events dropped on a full queue
+ *
+ * @param[in]  None
+ *
+ * @retval uint32_t
+ *
+ */
+uint32_t Event_Get_Dropped_Count(void);
+
+#endif /* EVENT_BUS_H */
@@ -20,6 +20,9 @@
 #define NUM_ROWS    4
 #define NUM_COLS    4
 
+/* Keypad_Scan_Matrix bit of the key at row, col of KeyMap */
+#define KEYPAD_KEY_BIT(__ROW__, __COL__)    ((uint16_t)(1U << (((__ROW__) * NUM_COLS) + (__COL__))))
+
 /*==================================================================================================
                                            CONSTANTS
 ==================================================================================================*/
@@ -65,10 +68,22 @@ typedef enum{
  *
  * @retval     Keypad_Button_Type 
  *
- * @note Should be called in thread or created a new thread 
+ * @note Thread context, the keypad and switch may be scanned from different tasks:
+ *       the 74LS151 select lines are locked
  */
 Keypad_Button_Type Keypad_Scan(uint8_t *pkey);
 
+/**
+ * @brief  This function uses to scan every key, for chords
+ *
+ * @param[in]  None
+ *
+ * @retval     uint16_t KEYPAD_KEY_BIT of each key pushed, 0 when none is or the keypad is not connected
+ *
+ * @note Thread context. Keys of one column never ghost, three keys on the corners of a rectangle do
+ */
+uint16_t Keypad_Scan_Matrix(void);
+
 /**
  * @brief  This function uses to return vaue of the switch which define address of device 
  *
@@ -76,9 +91,31 @@ Keypad_Button_Type Keypad_Scan(uint8_t *pkey);
  *
  * @retval     uint8_t Address value of the device
  *
- * @note Should be called in thread or created a new thread 
+ * @note Thread context, the keypad and switch may be scanned from different tasks:
+ *       the 74LS151 select lines are locked
  */
 uint8_t Config_Switch_Get_Value(void);
+/**
+ * @brief  This function uses to scan the keypad and publish EVENT_KEY_PRESSED when a key goes down
+ *
+ * @param[in]  None
+ *
+ * @retval     void
+ *
+ * @note Should be called in the main loop. Event data is the key name, first char | second char << 8,
+ *       a held key is published once
+ */
+void Keypad_Task(void);
+/**
+ * @brief  This function uses to read the address switch and publish EVENT_SWITCH_CHANGED on change
+ *
+ * @param[in]  None
+ *
+ * @retval     void
+ *
+ * @note Should be called in the main loop, the first call always publishes
+ */
+void Config_Switch_Task(void);
 
 
 #endif /* KEYPAD_H */
@@ -27,6 +27,16 @@
 #define LCD_CMD_DIS_CLEAR			0x01
 /* Return Cursor to home */
 #define LCD_CMD_DIS_RETURN_HOME		0x02
+/* Shift the whole display (both lines) one position left */
+#define LCD_CMD_SHIFT_LEFT			0x18
+
+/* Visible lines and columns, and DDRAM positions per line the display shift runs through */
+#define LCD_CHARACTER_LINES         (2U)
+#define LCD_CHARACTER_COLS          (16U)
+#define LCD_CHARACTER_DDRAM_COLS    (40U)
+
+/* Marquee step period used when 0 is passed to Lcd_Marquee_Start */
+#define LCD_MARQUEE_DEFAULT_STEP_MS (400U)
 /*==================================================================================================
                                            CONSTANTS
 ==================================================================================================*/
@@ -34,6 +44,17 @@
 /*==================================================================================================
 *                                              ENUMS
 ==================================================================================================*/
+/**
+ * @brief Lcd_Init_State_Type, power-on sequence of the HD44780 (datasheet figure 24)
+ */
+typedef enum
+{
+    LCD_INIT_POWER_ON       = 0U,   /* Waiting 40 ms after VCC rises */
+    LCD_INIT_WAKE_UP_1,             /* First 0x3 sent, waiting 5 ms */
+    LCD_INIT_WAKE_UP_2,             /* Second 0x3 sent, waiting 150 us */
+    LCD_INIT_CLEAR,                 /* Configured and clear sent, waiting 2 ms */
+    LCD_INIT_DONE
+} Lcd_Init_State_Type;
 
 /*==================================================================================================
 *                                  STRUCTURES AND OTHER TYPEDEFS
@@ -57,6 +78,38 @@
  */
 void Lcd_Init_4bits_Mode(void);
 
+/**
+ * @brief  This function uses to start the 4 bits mode initialization without waiting
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ *
+ * @note The sequence is completed by Lcd_Init_4bits_Mode_Poll, other drivers can run meanwhile.
+ *       The LCD lock is created here, before the threads using the LCD start
+ */
+void Lcd_Init_4bits_Mode_Start(void);
+
+/**
+ * @brief  This function uses to run the initialization step whose wait has elapsed
+ *
+ * @param[in]  None
+ *
+ * @retval Lcd_Init_State_Type : LCD_INIT_DONE once the LCD accepts commands and data
+ *
+ * @note Never busy-waits for the long power-on delays, only for the 40 us command times
+ */
+Lcd_Init_State_Type Lcd_Init_4bits_Mode_Poll(void);
+
+/**
+ * @brief  This function uses to get the deadline of the pending initialization step
+ *
+ * @param[in]  None
+ *
+ * @retval uint32_t : Timebase deadline
+ */
+uint32_t Lcd_Init_4bits_Mode_Get_Deadline(void);
+
 /**
  * @brief  This function uses to clear the LCD
  *
@@ -86,6 +139,7 @@ void Lcd_Put_Char(uint8_t data);
  *
  * @retval void
  *
+ * @note The whole string goes out before another task can write to the LCD
  */
 void Lcd_Put_String(uint8_t line, uint8_t offset, uint8_t *pString);
  
@@ -120,6 +174,42 @@ void Lcd_Set_Cursor(uint8_t line, uint8_t offset);
  */
  void Lcd_Turn_Off_Cursor(void);
 
+/**
+ * @brief  This function uses to scroll a text longer than the display on one line
+ *
+ * @param[in]  line     : line number (0 to 1)
+ *             pString  : text, only the first LCD_CHARACTER_DDRAM_COLS characters are used
+ *             StepMs   : time between two shifts, 0 for LCD_MARQUEE_DEFAULT_STEP_MS
+ *
+ * @retval void
+ *
+ * @note The text is written once into the 40 DDRAM positions of the line, each step is then a
+ *       single display shift command. The HD44780 shifts both lines together, so the other line
+ *       scrolls as well. A text that fits on the display is written without scrolling
+ */
+void Lcd_Marquee_Start(uint8_t line, const uint8_t *pString, uint16_t StepMs);
+
+/**
+ * @brief  This function uses to stop scrolling and put the display back to its home position
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ *
+ */
+void Lcd_Marquee_Stop(void);
+
+/**
+ * @brief  This function uses to run the marquee service
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ *
+ * @note Should be called in the main loop, sends one shift command when a step is due
+ */
+void Lcd_Marquee_Task(void);
+
 /**
  * @brief  This function uses to get current 74HC595 value of LCD character
  *
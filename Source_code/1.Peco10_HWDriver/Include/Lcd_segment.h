@@ -20,11 +20,59 @@
 #define SCE_PIN                                 GPIO_PIN_14
 #define SCE_PORT                                GPIOC
 
+/* Driver chips sharing SPI1, each one with its own SCE pin and device code.
+ * Driver d shows lines d*LCD_SEGMENT_ROWS to d*LCD_SEGMENT_ROWS+2, line numbers run across the chips */
+#ifndef LCD_SEGMENT_DRIVER_COUNT
+#define LCD_SEGMENT_DRIVER_COUNT                (1U)
+#endif
+/* { SCE port, SCE pin, device code } of each driver, in line order */
+#ifndef LCD_SEGMENT_DRIVER_CONFIG
+#define LCD_SEGMENT_DRIVER_CONFIG               { { SCE_PORT, SCE_PIN, LCD_DEVICE_CODE } }
+#endif
+#if (LCD_SEGMENT_DRIVER_COUNT == 0U) || (LCD_SEGMENT_DRIVER_COUNT > 7U)
+#error "LCD_SEGMENT_DRIVER_COUNT must be 1 to 7, Lcd_Segment_Put_Ram offsets are 8 bit"
+#endif
+#define LCD_SEGMENT_LINES                       (LCD_SEGMENT_ROWS*LCD_SEGMENT_DRIVER_COUNT)
+
 #define LCD_SPI_INSTANCE                        &hspi1
+#define LCD_SPI                                 SPI1
+
+/* 1: send the frames with HAL_SPI_Transmit/HAL_SPI_Transmit_IT, kept to benchmark against
+ * 0: register level SPI1 writes straight into the TX FIFO */
+#ifndef LCD_SEGMENT_SPI_HAL
+#define LCD_SEGMENT_SPI_HAL                     (0U)
+#endif
+#if (PECO10_LL_BUILD == 1U) && (LCD_SEGMENT_SPI_HAL == 1U)
+#error "LCD_SEGMENT_SPI_HAL needs the HAL SPI driver, not available in the LL build"
+#endif
 
 #define LCD_DEVICE_CODE                         (0x42U)
 #define LCD_DISPLAY_RAM_SIZE                    (35U)
+/* Display RAM of all drivers, driver d starts at d*LCD_DISPLAY_RAM_SIZE */
+#define LCD_SEGMENT_RAM_SIZE                    (LCD_DISPLAY_RAM_SIZE*LCD_SEGMENT_DRIVER_COUNT)
 #define LCD_FRAME_LENGTH                        (12U)
+#define LCD_FRAME_COUNT                         (4U)
+
+/* Indicator icons, bits of the first display RAM byte of driver 0, can be ORed together */
+#define LCD_INDICATOR_1                         (0x80U)
+#define LCD_INDICATOR_2                         (0x40U)
+#define LCD_INDICATOR_3                         (0x20U)
+#define LCD_INDICATOR_4                         (0x10U)
+#define LCD_INDICATOR_5                         (0x08U)
+#define LCD_INDICATOR_ALL                       (0xF8U)
+
+/* Digit mask for Lcd_Segment_Blink_Digits, col 1 is the leftmost digit, col 7 the rightmost */
+#define LCD_SEGMENT_DIGIT(__COL__)              ((uint8_t)(1U << ((__COL__) - 1U)))
+
+/* Longest marquee text (dots and commas included) and default step period */
+#define LCD_SEGMENT_MARQUEE_SIZE                (48U)
+#define LCD_SEGMENT_MARQUEE_DEFAULT_STEP_MS     (300U)
+
+/* Blink half period (on time = off time) used until Lcd_Segment_Set_Blink_Rate is called */
+#define LCD_SEGMENT_BLINK_DEFAULT_MS            (500U)
+
+/* Ring mask to pass to Lcd_Segment_Put_Data_Ring for a plain (non wrapping) array */
+#define LCD_SEGMENT_LINEAR_MASK                 (0xFFFFU)
 /*==================================================================================================
                                            CONSTANTS
 ==================================================================================================*/
@@ -36,6 +84,15 @@ extern SPI_HandleTypeDef hspi1;
 /*==================================================================================================
 *                                  STRUCTURES AND OTHER TYPEDEFS
 ==================================================================================================*/
+/**
+ * @brief Lcd_Segment_Driver_Type, one driver chip on the SPI bus
+ */
+typedef struct
+{
+    GPIO_TypeDef* CsPort;                       /* SCE port */
+    uint16_t CsPin;                             /* SCE pin, active high */
+    uint8_t DeviceCode;                         /* Sent with SCE low before each frame */
+} Lcd_Segment_Driver_Type;
 
 /*==================================================================================================
 *                                  GLOBAL VARIABLE DECLARATIONS
@@ -52,6 +109,8 @@ void Lcd_Segment_Display_App(void);
  *
  * @retval void
  *
+ * @note The other functions lock the display RAM and the SPI bus, any task may call them
+ *       once this has run
  */
 void Lcd_Segment_Init(void);
 
@@ -66,6 +125,45 @@ void Lcd_Segment_Init(void);
  */
 void Lcd_Segment_Put_Data(uint8_t* pData, uint8_t line);
 
+/**
+ * @brief  This function uses to prepare data of one line read in place from a ring buffer
+ *
+ * @param[in]  line    : line which data will be displayed
+ *             pRing   : ring buffer base
+ *             Mask    : ring size - 1 (power of 2), LCD_SEGMENT_LINEAR_MASK for a plain array
+ *             Start   : index of the first character in the ring
+ *             len     : number of characters (dot and comma included)
+ *
+ * @retval void
+ *
+ * @note Characters are right aligned exactly like Lcd_Segment_Put_Data, nothing is copied
+ */
+void Lcd_Segment_Put_Data_Ring(uint8_t line, const uint8_t* pRing, uint16_t Mask, uint16_t Start, uint16_t len);
+
+/**
+ * @brief  This function uses to redraw one digit, the rest of the line is kept
+ *
+ * @param[in]  line  : LCD line index [0-LCD_SEGMENT_LINES-1]
+ *             col   : col index [1-7], col 1 is the leftmost digit
+ *             Data  : character, '.' or ',' adds the separator following the digit
+ *
+ * @retval Std_Return_Type
+ *
+ * @note Only the display RAM is updated, call Lcd_Segment_Flush to send the change
+ */
+Std_Return_Type Lcd_Segment_Put_Char(uint8_t line, uint8_t col, uint8_t Data);
+
+/**
+ * @brief  This function uses to send the frames that changed since they were last built
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ *
+ * @note Lcd_Segment_Display_App sends all frames, this one only the dirty ones
+ */
+void Lcd_Segment_Flush(void);
+
 /**
  * @brief  This function uses to prepare data which will be displayed in indicator position in LCD segment
  *
@@ -76,6 +174,104 @@ void Lcd_Segment_Put_Data(uint8_t* pData, uint8_t line);
  */
 void Lcd_Segment_Put_Indicator(uint8_t Data);
 
+/**
+ * @brief  This function uses to switch some indicators on or off
+ *
+ * @param[in]  Indicators : LCD_INDICATOR_x mask
+ *             State      : 1 on, 0 off
+ *
+ * @retval void
+ *
+ */
+void Lcd_Segment_Set_Indicator(uint8_t Indicators, uint8_t State);
+
+/**
+ * @brief  This function uses to choose which indicators blink
+ *
+ * @param[in]  Indicators : LCD_INDICATOR_x mask, 0 stops blinking
+ *
+ * @retval void
+ *
+ * @note Only indicators that are on blink, an indicator switched off stays off
+ */
+void Lcd_Segment_Blink_Indicator(uint8_t Indicators);
+
+/**
+ * @brief  This function uses to choose which digits of a line blink
+ *
+ * @param[in]  line  : LCD line index [0-LCD_SEGMENT_LINES-1]
+ *             Cols  : LCD_SEGMENT_DIGIT(col) mask, 0 stops blinking
+ *
+ * @retval Std_Return_Type
+ *
+ * @note The attribute is bound to the digit position, the line content can change freely
+ */
+Std_Return_Type Lcd_Segment_Blink_Digits(uint8_t line, uint8_t Cols);
+
+/**
+ * @brief  This function uses to show the edit cursor on a line
+ *
+ * @param[in]  line  : LCD line index [0-LCD_SEGMENT_LINES-1]
+ *             col   : digit being edited [1-7], 0 removes the cursor
+ *
+ * @retval Std_Return_Type
+ *
+ * @note The cursor is the decimal point following the digit. While it is shown the dots and
+ *       commas of the line are hidden so it cannot be confused with them
+ */
+Std_Return_Type Lcd_Segment_Set_Cursor(uint8_t line, uint8_t col);
+
+/**
+ * @brief  This function uses to set the blink rate
+ *
+ * @param[in]  HalfPeriodMs : on time and off time in ms, 0 is taken as 1
+ *
+ * @retval void
+ *
+ */
+void Lcd_Segment_Set_Blink_Rate(uint16_t HalfPeriodMs);
+
+/**
+ * @brief  This function uses to run the blink service
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ *
+ * @note Should be called in the main loop. On each blink edge only the blinking segment bits
+ *       are toggled and only the frames holding them are sent to the driver
+ */
+void Lcd_Segment_Blink_Task(void);
+
+/**
+ * @brief  This function uses to display a signed number right aligned on one line
+ *
+ * @param[in]  line          : LCD line index [0-LCD_SEGMENT_LINES-1]
+ *             Value         : number to display
+ *             DecimalPlace  : digits after the separator [0-6], 0 for none
+ *             Separator     : '.' or ','
+ *
+ * @retval Std_Return_Type
+ *
+ * @note Leading zeros are kept down to the units digit, E_NOT_OK and a line of '-' on overflow
+ */
+Std_Return_Type Lcd_Segment_Put_Number(uint8_t line, int32_t Value, uint8_t DecimalPlace, uint8_t Separator);
+
+/**
+ * @brief  This function uses to write raw bytes into the LCD display RAM
+ *
+ * @param[in]  Offset  : first display RAM byte [0-LCD_SEGMENT_RAM_SIZE-1], driver d at d*35
+ *             pRing   : ring buffer base
+ *             Mask    : ring size - 1 (power of 2), LCD_SEGMENT_LINEAR_MASK for a plain array
+ *             Start   : index of the first byte in the ring
+ *             len     : number of bytes
+ *
+ * @retval Std_Return_Type
+ *
+ * @note Bytes are taken as is (segment bits, not characters), E_NOT_OK if past the RAM end
+ */
+Std_Return_Type Lcd_Segment_Put_Ram(uint8_t Offset, const uint8_t* pRing, uint16_t Mask, uint16_t Start, uint16_t len);
+
 /**
  * @brief  This function uses to start  display frame to LCD segment
  *
@@ -86,6 +282,115 @@ void Lcd_Segment_Put_Indicator(uint8_t Data);
  */
 void Lcd_Segment_Start_Display(void);
 
+/**
+ * @brief  This function uses to blank the panel and put the driver in power saving mode
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ *
+ * @note Sends one DD=00 frame with SC and BU set to each driver. Lcd_Segment_Display_App keeps updating the
+ *       cached frames without sending them until Lcd_Segment_Resume
+ */
+void Lcd_Segment_Power_Save(void);
+
+/**
+ * @brief  This function uses to leave power saving mode
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ *
+ * @note Resends the cached frames of every driver in one burst, the application does not need to redraw
+ */
+void Lcd_Segment_Resume(void);
+
+/**
+ * @brief  This function uses to know whether the driver is in power saving mode
+ *
+ * @param[in]  None
+ *
+ * @retval uint8_t : 1 in power saving mode, 0 otherwise
+ *
+ */
+uint8_t Lcd_Segment_Is_Power_Save(void);
+
+/**
+ * @brief  This function uses to scroll a text longer than 7 digits on one line
+ *
+ * @param[in]  line     : LCD line index [0-LCD_SEGMENT_LINES-1]
+ *             pData    : text (dot and comma included)
+ *             len      : number of characters, at most LCD_SEGMENT_MARQUEE_SIZE
+ *             StepMs   : time between two steps, 0 for LCD_SEGMENT_MARQUEE_DEFAULT_STEP_MS
+ *
+ * @retval Std_Return_Type
+ *
+ * @note The text is kept in a per line buffer read as a ring, 7 blank digits separate two
+ *       passes. A text that fits on the line is shown right aligned without scrolling
+ */
+Std_Return_Type Lcd_Segment_Marquee_Start(uint8_t line, const uint8_t* pData, uint16_t len, uint16_t StepMs);
+
+/**
+ * @brief  This function uses to stop scrolling a line, the current window stays displayed
+ *
+ * @param[in]  line  : LCD line index [0-LCD_SEGMENT_LINES-1]
+ *
+ * @retval void
+ *
+ */
+void Lcd_Segment_Marquee_Stop(uint8_t line);
+
+/**
+ * @brief  This function uses to run the marquee service
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ *
+ * @note Should be called in the main loop. A step redraws the 9 display RAM bytes of the line
+ *       and sends only the frames that changed
+ */
+void Lcd_Segment_Marquee_Task(void);
+
+/**
+ * @brief  This function uses to get the duration of the last refresh, from the first frame sent to the last
+ *
+ * @param[in]  None
+ *
+ * @retval uint32_t : us, compare builds with LCD_SEGMENT_SPI_HAL 0 and 1 to benchmark the SPI path
+ *
+ */
+uint32_t Lcd_Segment_Get_Refresh_Time(void);
+
+/**
+ * @brief  This function uses to know whether frames are still being sent
+ *
+ * @param[in]  None
+ *
+ * @retval uint8_t : 1 while the DMA chain runs, 0 otherwise
+ *
+ * @note With LCD_SEGMENT_SPI_HAL 0 the frames go out in the background, the display RAM can be
+ *       changed meanwhile, the next flush waits for the chain to end
+ */
+uint8_t Lcd_Segment_Is_Busy(void);
+
+/**
+ * @brief  This function uses to wait until the frames started are all sent and SCE is released
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ *
+ * @note The core sleeps until the DMA interrupt ends the chain. Called before Stop mode,
+ *       which would halt SPI1 and the DMA in the middle of a frame
+ */
+void Lcd_Segment_Wait_Idle(void);
+
+/**
+ * @brief  DMA1 channel 2 interrupt handler, called from DMA1_Channel2_3_IRQHandler
+ */
+void Lcd_Segment_Dma_IRQHandler(void);
+
 /**
  * @brief  This function uses to get the current code is diaplayed in LCD segment
  *
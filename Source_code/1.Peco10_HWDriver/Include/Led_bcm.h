@@ -0,0 +1,131 @@
+#ifndef LED_BCM_H
+#define LED_BCM_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+
+#include "Standard.h"
+#include "main.h"
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+/* Binary code modulation on the 74HC595 outputs, bit planes timed by TIM2 CC2 (1 us ticks) */
+#define LED_BCM_TIM                             TIM2
+#define LED_BCM_BITS                            (8U)
+#define LED_BCM_LEVEL_MAX                       (255U)
+
+/* Time plane 0 is shown, plane n is shown 2^n times longer: one cycle is 255 base periods.
+ * The base period is measured when the engine starts: one chain update at 16 MHz (the idle
+ * clock) times LED_BCM_BASE_FACTOR, which covers the interrupt entry and leaves the rest of the
+ * plane to the main loop, and never below LED_BCM_BASE_MIN_US. A cycle longer than 10 ms
+ * (base above 39 us) flickers, Led_Bcm_Get_Base_Us tells the value on the target */
+#define LED_BCM_BASE_FACTOR                     (2U)
+#ifndef LED_BCM_BASE_MIN_US
+#define LED_BCM_BASE_MIN_US                     (20U)
+#endif
+
+/* Chain updates timed for the base period, the fastest one is kept (interrupts landing in it) */
+#define LED_BCM_CALIBRATION_RUNS                (4U)
+
+/* Plane shown while the engine is suspended: levels from 128 up are on, the others off */
+#define LED_BCM_STATIC_PLANE                    (LED_BCM_BITS - 1U)
+/*==================================================================================================
+                                           CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                              ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+/**
+ * @brief  This function uses to set the brightness of one 74HC595 output
+ *
+ * @param[in]  Output  : IC_74HC595_OUTPUT(stage, bit)
+ *             Level   : 0 off to LED_BCM_LEVEL_MAX fully on
+ *
+ * @retval Std_Return_Type
+ *
+ * @note The output is driven by the BCM engine from now on, the bit planes are rebuilt here
+ *       so the interrupt only latches precomputed images. E_NOT_OK if Output is not on the chain.
+ *       Thread context only, TIM2 DIER is shared with Timebase_Wait_Until
+ */
+Std_Return_Type Led_Bcm_Set_Level(uint16_t Output, uint8_t Level);
+
+/**
+ * @brief  This function uses to get the brightness of one 74HC595 output
+ *
+ * @param[in]  Output  : IC_74HC595_OUTPUT(stage, bit)
+ *
+ * @retval uint8_t : level, 0 when the output is not driven by the BCM engine
+ *
+ */
+uint8_t Led_Bcm_Get_Level(uint16_t Output);
+
+/**
+ * @brief  This function uses to give one output back to the IC_74hc595_xxx_Bit functions
+ *
+ * @param[in]  Output  : IC_74HC595_OUTPUT(stage, bit)
+ *
+ * @retval void
+ *
+ * @note The output is cleared. The timer interrupt stops with the last BCM output
+ */
+void Led_Bcm_Release(uint16_t Output);
+
+/**
+ * @brief  This function uses to get the base period measured when the engine started
+ *
+ * @param[in]  None
+ *
+ * @retval uint32_t : plane 0 time in us, 0 before the first Led_Bcm_Set_Level
+ */
+uint32_t Led_Bcm_Get_Base_Us(void);
+
+/**
+ * @brief  This function uses to stop the bit planes and latch a static image
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ *
+ * @note Before Stop mode, TIM2 stops there and the outputs would hold whatever plane was
+ *       shown. Each output shows its level rounded to on or off until Led_Bcm_Resume
+ */
+void Led_Bcm_Suspend(void);
+
+/**
+ * @brief  This function uses to restart the bit planes after Led_Bcm_Suspend
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ */
+void Led_Bcm_Resume(void);
+
+/**
+ * @brief  This function uses to latch the next bit plane on the TIM2 CC2 compare
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ *
+ * @note Called from TIM2_IRQHandler, returns at once when CC2 is not pending
+ */
+void Led_Bcm_Timer_IRQHandler(void);
+
+#endif /* LED_BCM_H */
@@ -0,0 +1,69 @@
+#ifndef LL_INIT_H
+#define LL_INIT_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+
+#include "main.h"
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+/* Ll_Init_Gpio modes, MODER encoding */
+#define LL_INIT_GPIO_MODE_INPUT                 (0U)
+#define LL_INIT_GPIO_MODE_OUTPUT                (1U)
+#define LL_INIT_GPIO_MODE_ALTERNATE             (2U)
+
+/* Ll_Init_Gpio pulls, PUPDR encoding */
+#define LL_INIT_GPIO_PULL_NO                    (0U)
+#define LL_INIT_GPIO_PULL_UP                    (1U)
+/*==================================================================================================
+                                           CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                              ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+#if (PECO10_LL_BUILD == 1U)
+/**
+ * @brief  This function uses to replace HAL_Init, SystemClock_Config and the MX_*_Init calls
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ *
+ * @note Same configuration as the CubeMX code: HSI16, GPIO, TIM1 CH1 PWM 1 kHz, TIM2 free
+ *       running 1 MHz, SPI1 master 8 bit. SysTick is not started, Timebase replaces it
+ */
+void Ll_Init_System(void);
+
+/**
+ * @brief  This function uses to configure GPIO pins, push-pull, low speed
+ *
+ * @param[in]  Port       : GPIO port
+ *             Pins       : GPIO_PIN_x mask
+ *             Mode       : LL_INIT_GPIO_MODE_x
+ *             Pull       : LL_INIT_GPIO_PULL_x
+ *             Alternate  : alternate function number, used in LL_INIT_GPIO_MODE_ALTERNATE
+ *
+ * @retval void
+ */
+void Ll_Init_Gpio(GPIO_TypeDef* Port, uint32_t Pins, uint32_t Mode, uint32_t Pull, uint32_t Alternate);
+#endif
+
+#endif /* LL_INIT_H */
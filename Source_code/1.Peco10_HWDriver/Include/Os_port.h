@@ -0,0 +1,133 @@
+#ifndef OS_PORT_H
+#define OS_PORT_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+
+#include <stdint.h>
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+/* OS_PORT values: the drivers run in the main loop of the firmware, or as POSIX threads on the
+ * host. OS_PORT_POSIX is built and checked by Tools/host (make): Os_port.c, Event_bus.c and the
+ * 74HC595, 74LS151 and keypad drivers, with threads standing in for the tasks and interrupts.
+ * There is no kernel port for the target: the project has no RTOS component to build one against */
+#define OS_PORT_BARE_METAL                      (0U)
+#define OS_PORT_POSIX                           (2U)
+
+#ifndef OS_PORT
+#define OS_PORT                                 OS_PORT_BARE_METAL
+#endif
+
+/* Os_Semaphore_Take timeout without limit */
+#define OS_WAIT_FOREVER                         (0xFFFFFFFFU)
+
+#if (OS_PORT == OS_PORT_POSIX)
+#include <pthread.h>
+#include <semaphore.h>
+#elif (OS_PORT != OS_PORT_BARE_METAL)
+#error "OS_PORT must be OS_PORT_BARE_METAL or OS_PORT_POSIX"
+#endif
+/*==================================================================================================
+                                           CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                              ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief Os_Mutex_Type, recursive with priority inheritance
+ *        Os_Semaphore_Type, binary, given from thread or interrupt context
+ */
+#if (OS_PORT == OS_PORT_POSIX)
+typedef pthread_mutex_t Os_Mutex_Type;
+typedef sem_t Os_Semaphore_Type;
+#else
+/* One thread: nothing to lock, the semaphore is the wake flag of Timebase_Sleep_Until */
+typedef uint8_t Os_Mutex_Type;
+typedef volatile uint8_t Os_Semaphore_Type;
+#endif
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+/**
+ * @brief  This function uses to create a mutex
+ *
+ * @param[out] pMutex  : mutex to create
+ *
+ * @retval void
+ *
+ * @note Called by the driver Init functions, before the threads using the driver start
+ */
+void Os_Mutex_Init(Os_Mutex_Type* pMutex);
+
+/**
+ * @brief  This function uses to lock or unlock a mutex, the owner may lock it again
+ *
+ * @param[in]  pMutex  : mutex created by Os_Mutex_Init
+ *
+ * @retval void
+ *
+ * @note Thread context only
+ */
+void Os_Mutex_Lock(Os_Mutex_Type* pMutex);
+void Os_Mutex_Unlock(Os_Mutex_Type* pMutex);
+
+/**
+ * @brief  This function uses to create a semaphore, not given
+ *
+ * @param[out] pSemaphore  : semaphore to create
+ *
+ * @retval void
+ */
+void Os_Semaphore_Init(Os_Semaphore_Type* pSemaphore);
+
+/**
+ * @brief  This function uses to give a semaphore, several gives before a take count as one
+ *
+ * @param[in]  pSemaphore  : semaphore created by Os_Semaphore_Init
+ *
+ * @retval void
+ *
+ * @note Safe to be called from thread and interrupt context
+ */
+void Os_Semaphore_Give(Os_Semaphore_Type* pSemaphore);
+
+/**
+ * @brief  This function uses to wait for a semaphore
+ *
+ * @param[in]  pSemaphore  : semaphore created by Os_Semaphore_Init
+ *             TimeoutUs   : longest wait, OS_WAIT_FOREVER for no limit
+ *
+ * @retval uint8_t 1 when the semaphore was given, 0 on timeout
+ *
+ * @note Thread context only, the caller checks its condition again after a take:
+ *       a give can be left over from a condition already handled
+ */
+uint8_t Os_Semaphore_Take(Os_Semaphore_Type* pSemaphore, uint32_t TimeoutUs);
+
+/**
+ * @brief  This function uses to let the other threads run for at most us microseconds
+ *
+ * @param[in]  us  : time to give away
+ *
+ * @retval void
+ *
+ * @note Nothing is done on bare metal, there is no other thread and the caller's own wait
+ *       sleeps in WFI
+ */
+void Os_Sleep_Us(uint32_t us);
+
+#endif /* OS_PORT_H */
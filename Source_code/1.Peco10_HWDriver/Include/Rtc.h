@@ -0,0 +1,103 @@
+#ifndef RTC_H
+#define RTC_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+
+#include "Standard.h"
+#include "main.h"
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+/* LSI 32 kHz / (PREDIV_A + 1) / (PREDIV_S + 1) = 1 Hz calendar clock (PC14/PC15 are GPIO, no LSE) */
+#define RTC_ASYNCH_PREDIV                       (127U)
+#define RTC_SYNCH_PREDIV                        (249U)
+
+/* Date and time in the Settings format: 0xYYYYMMDD and 0x00HHMMSS, BCD */
+#define RTC_DEFAULT_DATE                        (0x20220101U)
+#define RTC_DEFAULT_TIME                        (0x00000000U)
+/*==================================================================================================
+                                           CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                              ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+/**
+ * @brief  This function uses to start the RTC on LSI with a 1 s wake-up interrupt (EVENT_RTC_SECOND)
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ *
+ * @note Should be called after Settings_Init. The calendar keeps running through a reset,
+ *       after a power loss it restarts from the last date and time set
+ */
+void Rtc_Init(void);
+
+/**
+ * @brief  This function uses to read the calendar
+ *
+ * @param[in,out]  pDate  : 0xYYYYMMDD BCD
+ *                 pTime  : 0x00HHMMSS BCD
+ *
+ * @retval void
+ *
+ */
+void Rtc_Get_Date_Time(uint32_t* pDate, uint32_t* pTime);
+
+/**
+ * @brief  This function uses to set the calendar and store it in the settings
+ *
+ * @param[in]  Date  : 0xYYYYMMDD BCD, year 2000 to 2099
+ *             Time  : 0x00HHMMSS BCD, 24 hours
+ *
+ * @retval Std_Return_Type
+ *
+ * @note E_NOT_OK if a field is not a valid BCD value or the day is past the end of the month,
+ *       nothing is changed then. The weekday is computed from the date
+ */
+Std_Return_Type Rtc_Set_Date_Time(uint32_t Date, uint32_t Time);
+
+/**
+ * @brief  This function uses to enter Stop 1 mode until the next interrupt
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ *
+ * @note Must be called in TIMEBASE_CLOCK_SLOW, the core wakes up on HSI16 like before. TIM1,
+ *       TIM2 and USART2 are stopped meanwhile: the backlight PWM output freezes. The time spent
+ *       in Stop is read from the RTC subseconds and added to the timebase on wake-up, so the
+ *       deadlines keep their length (4 ms resolution)
+ */
+void Rtc_Stop_Until_Wakeup(void);
+
+/**
+ * @brief  This function uses to acknowledge the RTC wake-up interrupt
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ *
+ * @note Called from RTC_TAMP_IRQHandler, publishes EVENT_RTC_SECOND
+ */
+void Rtc_IRQHandler(void);
+
+#endif /* RTC_H */
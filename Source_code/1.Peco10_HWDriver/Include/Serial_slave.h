@@ -0,0 +1,154 @@
+#ifndef SERIAL_SLAVE_H
+#define SERIAL_SLAVE_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+
+#include "Standard.h"
+#include "main.h"
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+/* USART2 on PA2 (TX) / PA3 (RX), AF1 */
+#define SERIAL_USART                            USART2
+#define SERIAL_GPIO_PORT                        GPIOA
+#define SERIAL_TX_PIN                           GPIO_PIN_2
+#define SERIAL_RX_PIN                           GPIO_PIN_3
+/* EXTI line of the RX pin, wakes the core from Stop on a start bit */
+#define SERIAL_RX_EXTI_LINE                     (3U)
+#define SERIAL_BAUDRATE                         (115200U)
+
+/* DMA receive ring, must be a power of 2 and hold the longest frame */
+#define SERIAL_RX_BUFFER_SIZE                   (256U)
+/* Number of idle-line frame ends queued between two Serial_Slave_Process calls */
+#define SERIAL_FRAME_QUEUE_SIZE                 (4U)
+
+/*
+ * Frame layout, one frame per idle-line period:
+ *  [0]     SERIAL_FRAME_START
+ *  [1]     Address (Config_Switch_Get_Value) or SERIAL_ADDRESS_BROADCAST
+ *  [2]     Command
+ *  [3]     Payload length N
+ *  [4..]   Payload
+ *  [4+N]   Checksum, two's complement of the byte sum of [1..3+N]
+ */
+#define SERIAL_FRAME_START                      (0xA5U)
+#define SERIAL_ADDRESS_BROADCAST                (0xFFU)
+#define SERIAL_FRAME_OVERHEAD                   (5U)
+
+/* Segment LCD text line, payload: line, characters (dot and comma included) */
+#define SERIAL_CMD_SEGMENT_TEXT                 (0x01U)
+/* Segment LCD indicator byte, payload: indicator [, blinking indicators] */
+#define SERIAL_CMD_SEGMENT_INDICATOR            (0x02U)
+/* Character LCD text, payload: line, offset, characters. A line or offset off the display is an error */
+#define SERIAL_CMD_CHARACTER_TEXT               (0x03U)
+/* Character LCD clear, no payload */
+#define SERIAL_CMD_CHARACTER_CLEAR              (0x04U)
+/* Binary display update batch, payload: records and CRC-32, see Display_delta.h */
+#define SERIAL_CMD_DISPLAY_DELTA                (0x05U)
+/* Segment LCD power, payload: SERIAL_SEGMENT_POWER_SAVE or SERIAL_SEGMENT_POWER_ON */
+#define SERIAL_CMD_SEGMENT_POWER                (0x06U)
+
+#define SERIAL_SEGMENT_POWER_ON                 (0x00U)
+#define SERIAL_SEGMENT_POWER_SAVE               (0x01U)
+/* Calendar, payload: date 0xYYYYMMDD and time 0x00HHMMSS, BCD, little endian */
+#define SERIAL_CMD_CALENDAR                     (0x07U)
+/*==================================================================================================
+                                           CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                              ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+/**
+ * @brief  This function uses to start USART2 reception into the DMA ring buffer
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ */
+void Serial_Slave_Init(void);
+
+/**
+ * @brief  This function uses to set the bus address the slave answers to
+ *
+ * @param[in]  Address  : value of the address switch
+ *
+ * @retval void
+ */
+void Serial_Slave_Set_Address(uint8_t Address);
+
+/**
+ * @brief  This function uses to decode the received frames and apply them to the displays
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ *
+ * @note Should be called in thread on EVENT_SERIAL_RECEIVED, payloads are read in place from the
+ *       DMA ring buffer. Publishes EVENT_SERIAL_FRAME with the command of each frame applied
+ */
+void Serial_Slave_Process(void);
+
+/**
+ * @brief  This function uses to get the number of valid frames addressed to this device
+ *
+ * @param[in]  None
+ *
+ * @retval uint32_t
+ */
+uint32_t Serial_Slave_Get_Frame_Count(void);
+
+/**
+ * @brief  This function uses to get the number of rejected frames (checksum, length, overrun, delta CRC)
+ *
+ * @param[in]  None
+ *
+ * @retval uint32_t
+ */
+uint32_t Serial_Slave_Get_Error_Count(void);
+
+/**
+ * @brief  This function uses to let a frame start wake the core from Stop mode
+ *
+ * @param[in]  Enable : 1 before entering Stop, 0 after waking up
+ *
+ * @retval void
+ *
+ * @note USART2 is not clocked in Stop, the frame that wakes the core is lost and has to be
+ *       repeated by the bus master. Kept off while running, it would fire on every start bit
+ */
+void Serial_Slave_Wakeup_Enable(uint8_t Enable);
+
+/**
+ * @brief  RX pin EXTI handler, called from EXTI2_3_IRQHandler
+ */
+void Serial_Slave_Wakeup_IRQHandler(void);
+
+/**
+ * @brief  USART2 interrupt handler, called from USART2_IRQHandler
+ */
+void Serial_Slave_Usart_IRQHandler(void);
+
+/**
+ * @brief  DMA1 channel 1 interrupt handler, called from DMA1_Channel1_IRQHandler
+ */
+void Serial_Slave_Dma_IRQHandler(void);
+
+#endif /* SERIAL_SLAVE_H */
@@ -0,0 +1,97 @@
+#ifndef SETTINGS_H
+#define SETTINGS_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+
+#include "Standard.h"
+#include "main.h"
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+/*
+ * Settings log in the last two flash pages, excluded from IROM in the project.
+ *
+ * Each page starts with a header double word {SETTINGS_PAGE_MAGIC, generation}, the page
+ * with the highest generation is the active one. Records are appended behind it, one
+ * double word each:
+ *  word 0  Value
+ *  word 1  [31..24] Key  [23..8] Sequence  [7..0] Check
+ * The latest record of a key is the one nearest to the end of the page. A full page is
+ * compacted into the other one, whose header is written last so a reset during the
+ * swap keeps the old page.
+ */
+#define SETTINGS_PAGE_SIZE                      FLASH_PAGE_SIZE
+#define SETTINGS_PAGE_A_ADDRESS                 (0x0800F000U)
+#define SETTINGS_PAGE_B_ADDRESS                 (SETTINGS_PAGE_A_ADDRESS + SETTINGS_PAGE_SIZE)
+#define SETTINGS_PAGE_MAGIC                     (0x31475453U)   /* "STG1" */
+/*==================================================================================================
+                                           CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                              ENUMS
+==================================================================================================*/
+/**
+ * @brief Settings_Key_Type
+ */
+typedef enum
+{
+    SETTINGS_KEY_DECIMAL_PLACE_TYPE = 0U,       /* 0 <-> ',' and 1 <-> '.' */
+    SETTINGS_KEY_BACKLIGHT_LEVEL,               /* Backlight level [0-100] */
+    SETTINGS_KEY_CALENDAR_DATE,                 /* Code 95 date, 0xYYYYMMDD */
+    SETTINGS_KEY_CALENDAR_TIME,                 /* Code 95 time, 0x00HHMMSS */
+    SETTINGS_KEY_COUNT
+} Settings_Key_Type;
+
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+/**
+ * @brief  This function uses to restore the latest settings from flash
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ *
+ * @note One backward scan of the active page, both pages are formatted if none is valid
+ */
+void Settings_Init(void);
+
+/**
+ * @brief  This function uses to get the value of a setting
+ *
+ * @param[in]      Key     : setting key
+ * @param[in,out]  pValue  : pointer to the value, untouched if the setting was never stored
+ *
+ * @retval Std_Return_Type
+ *
+ */
+Std_Return_Type Settings_Get(Settings_Key_Type Key, uint32_t* pValue);
+
+/**
+ * @brief  This function uses to store the value of a setting
+ *
+ * @param[in]  Key    : setting key
+ *             Value  : new value
+ *
+ * @retval Std_Return_Type
+ *
+ * @note Nothing is written if the value is unchanged. Blocks for a page erase (~40 ms)
+ *       when the active page is full, should be called in thread
+ */
+Std_Return_Type Settings_Set(Settings_Key_Type Key, uint32_t Value);
+
+#endif /* SETTINGS_H */
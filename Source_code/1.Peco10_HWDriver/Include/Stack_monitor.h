@@ -0,0 +1,87 @@
+#ifndef STACK_MONITOR_H
+#define STACK_MONITOR_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+
+#include "Standard.h"
+#include "main.h"
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+/* Word written over the free part of the stack, a word still equal to it was never used */
+#define STACK_MONITOR_PAINT                     (0xC5C5C5C5UL)
+
+/* Bytes left unpainted below the stack pointer at Stack_Monitor_Init, covers its own frame */
+#define STACK_MONITOR_MARGIN                    (32U)
+
+/* Lowest bytes of the stack which must stay painted, Stack_Monitor_Check fails once one is used.
+ * The heap lies right below the stack, an overflow would otherwise go unnoticed */
+#ifndef STACK_MONITOR_GUARD_BYTES
+#define STACK_MONITOR_GUARD_BYTES               (64U)
+#endif
+/*==================================================================================================
+                                           CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                              ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+/**
+ * @brief  This function uses to paint the unused part of the main stack (STACK area of the startup file)
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ *
+ * @note Should be called first in main, before anything deep has run. The Cortex-M0+ runs main and
+ *       every interrupt on this one stack (MSP)
+ */
+void Stack_Monitor_Init(void);
+
+/**
+ * @brief  This function uses to get the deepest use of the main stack since Stack_Monitor_Init
+ *
+ * @param[in]  None
+ *
+ * @retval uint32_t bytes used at most, main and interrupts together
+ *
+ * @note Scans the painted words from the bottom, a few us for the 1 KB stack
+ */
+uint32_t Stack_Monitor_Get_High_Water(void);
+
+/**
+ * @brief  This function uses to get the size of the main stack
+ *
+ * @param[in]  None
+ *
+ * @retval uint32_t Stack_Size of the startup file in bytes
+ */
+uint32_t Stack_Monitor_Get_Size(void);
+
+/**
+ * @brief  This function uses to check the guard at the bottom of the main stack
+ *
+ * @param[in]  None
+ *
+ * @retval Std_Return_Type E_NOT_OK when the stack came within STACK_MONITOR_GUARD_BYTES of its end
+ */
+Std_Return_Type Stack_Monitor_Check(void);
+
+#endif /* STACK_MONITOR_H */
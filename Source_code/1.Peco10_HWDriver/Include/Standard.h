@@ -10,6 +10,9 @@
 
 
 #include "main.h"
+#include "Timebase.h"
+#include "Trace.h"
+#include "Os_port.h"
 #include <stdio.h>
 #include <stdint.h>
 #include <string.h>
@@ -18,19 +21,45 @@
 ==================================================================================================*/
 #define DUMMY_DATA  0xFF
 
+/* Pin access, BSRR/BRR/IDR in the LL build where HAL_GPIO is not linked */
+#if (PECO10_LL_BUILD == 1U)
+#define STD_GPIO_WRITE(__PORT__, __PIN__, __STATE__)    ((void)(((__STATE__) != GPIO_PIN_RESET) ? \
+                                                         ((__PORT__)->BSRR = (__PIN__)) : ((__PORT__)->BRR = (__PIN__))))
+#define STD_GPIO_READ(__PORT__, __PIN__)                ((((__PORT__)->IDR & (__PIN__)) != 0U) ? GPIO_PIN_SET : GPIO_PIN_RESET)
+#else
+#define STD_GPIO_WRITE(__PORT__, __PIN__, __STATE__)    HAL_GPIO_WritePin((__PORT__), (__PIN__), (__STATE__))
+#define STD_GPIO_READ(__PORT__, __PIN__)                HAL_GPIO_ReadPin((__PORT__), (__PIN__))
+#endif
+
+/* Cascaded 74HC595: stage 0 (LCD_CHARACTER) is next to the MCU, stage 1 (KEYPAD) after it,
+ * extra stages for LEDs and relays follow at the far end of the chain */
+#ifndef IC_74HC595_STAGES
+#define IC_74HC595_STAGES   2U
+#endif
+#if (IC_74HC595_STAGES < 2U) || (IC_74HC595_STAGES > 32U)
+#error "IC_74HC595_STAGES must be 2 to 32"
+#endif
+/* Output number of bit (0 = Q0 ... 7 = Q7) of a stage, for the IC_74hc595_xxx_Bit functions */
+#define IC_74HC595_OUTPUT(__STAGE__, __BIT__)   ((uint16_t)(((__STAGE__) << 3U) | (__BIT__)))
+#define IC_74HC595_OUTPUTS  (IC_74HC595_STAGES << 3U)
+
 /* 74HC595 Shift_reg pins define */
 #define SHCP_PORT   GPIOB       
 #define SHCP_PIN    GPIO_PIN_7
-#define SHCP_SET    HAL_GPIO_WritePin(SHCP_PORT,SHCP_PIN,GPIO_PIN_SET)
-#define SHCP_CLR    HAL_GPIO_WritePin(SHCP_PORT,SHCP_PIN,GPIO_PIN_RESET)
+#define SHCP_SET    STD_GPIO_WRITE(SHCP_PORT,SHCP_PIN,GPIO_PIN_SET)
+#define SHCP_CLR    STD_GPIO_WRITE(SHCP_PORT,SHCP_PIN,GPIO_PIN_RESET)
 #define STCP_PORT   GPIOA       
 #define STCP_PIN    GPIO_PIN_6
-#define STCP_SET    HAL_GPIO_WritePin(STCP_PORT,STCP_PIN,GPIO_PIN_SET)
-#define STCP_CLR    HAL_GPIO_WritePin(STCP_PORT,STCP_PIN,GPIO_PIN_RESET)
+#define STCP_SET    STD_GPIO_WRITE(STCP_PORT,STCP_PIN,GPIO_PIN_SET)
+#define STCP_CLR    STD_GPIO_WRITE(STCP_PORT,STCP_PIN,GPIO_PIN_RESET)
 #define DS_PORT     GPIOA      
 #define DS_PIN      GPIO_PIN_4
-#define DS_SET      HAL_GPIO_WritePin(DS_PORT,DS_PIN,GPIO_PIN_SET)
-#define DS_CLR      HAL_GPIO_WritePin(DS_PORT,DS_PIN,GPIO_PIN_RESET)
+#define DS_SET      STD_GPIO_WRITE(DS_PORT,DS_PIN,GPIO_PIN_SET)
+#define DS_CLR      STD_GPIO_WRITE(DS_PORT,DS_PIN,GPIO_PIN_RESET)
+/* 74HC595 minimum pulse widths and setup times: 75 ns at VCC 2.0 V, 15 ns at 4.5 V. Nothing
+ * is given for 3.3 V so the 2.0 V figures are kept. One BSRR/BRR store is a single 15.6 ns cycle
+ * at 64 MHz: 4 NOPs and the next store make 5 cycles, 78 ns. Slower clocks only stretch it */
+#define IC_74HC595_TW_WAIT()    do{ __NOP(); __NOP(); __NOP(); __NOP(); }while(0)
 
 /* 74LS151 muxing pins define */
 #define A_PORT      GPIOB
@@ -44,7 +73,7 @@
 /*==================================================================================================
                                            CONSTANTS
 ==================================================================================================*/
-extern  TIM_HandleTypeDef htim2;
+
 /*==================================================================================================
 *                                              ENUMS
 ==================================================================================================*/
@@ -73,6 +102,15 @@ typedef enum
 /*==================================================================================================
 *                                       FUNCTION PROTOTYPES
 ==================================================================================================*/
+/**
+ * @brief Create the locks of the 74hc595 chain and the 74ls151 mux
+ *
+ * @return void
+ *
+ * @note Called before the threads using the chain or the mux start
+ */
+void Standard_Init(void);
+
 /**
  * @brief Latch input data in IC 74hc595
  *
@@ -101,6 +139,80 @@ void IC_74hc595_Output(void);
  */
 void IC_74hc595_Send_Data(uint8_t data, Device_Type Component);
 
+/**
+ * @brief Change the outputs of one device on the 74hc595 chain
+ *
+ * @param[in]  Device_Type  :Component whose stage is changed
+ * @param[in]  uint8_t      :Mask, stage bits to change
+ * @param[in]  uint8_t      :Value, new level of the masked bits
+ *
+ * @return E_OK when the change is latched on return,
+ *         E_NOT_OK when it preempted a shift and will be latched by it
+ *
+ * @note Safe from thread and interrupt context. The other stage keeps its image.
+ *       A thread preempting another thread's shift waits for it instead, so E_NOT_OK
+ *       only comes from interrupt context.
+ *       Changes posted while a shift is in progress are coalesced into one latch cycle,
+ *       so only the final state of such changes is guaranteed to reach the outputs
+ */
+Std_Return_Type IC_74hc595_Transaction(Device_Type Component, uint8_t Mask, uint8_t Value);
+
+/**
+ * @brief Change outputs of every stage of the 74hc595 chain in one transaction
+ *
+ * @param[in]  const uint8_t* :pMask, IC_74HC595_STAGES bytes, bits to change per stage
+ * @param[in]  const uint8_t* :pValue, IC_74HC595_STAGES bytes, new level of the masked bits
+ *
+ * @return same as IC_74hc595_Transaction
+ *
+ * @note Safe from interrupt context, used by the BCM engine to latch a bit plane
+ */
+Std_Return_Type IC_74hc595_Write_Chain(const uint8_t* pMask, const uint8_t* pValue);
+
+/**
+ * @brief Set, clear or toggle one output of the 74hc595 chain, latched by IC_74hc595_Flush
+ *
+ * @param[in]  uint16_t     :Output, IC_74HC595_OUTPUT(stage, bit)
+ *
+ * @return E_NOT_OK when Output is not on the chain
+ *
+ * @note Only the image is changed, any number of changes go out in the next latch cycle:
+ *       IC_74hc595_Flush or an IC_74hc595_Transaction of another stage
+ */
+Std_Return_Type IC_74hc595_Set_Bit(uint16_t Output);
+Std_Return_Type IC_74hc595_Clear_Bit(uint16_t Output);
+Std_Return_Type IC_74hc595_Toggle_Bit(uint16_t Output);
+
+/**
+ * @brief Get the image level of one output of the 74hc595 chain
+ *
+ * @param[in]  uint16_t     :Output, IC_74HC595_OUTPUT(stage, bit)
+ *
+ * @return 1 when the output is set, 0 when cleared or not on the chain
+ *
+ */
+uint8_t IC_74hc595_Get_Bit(uint16_t Output);
+
+/**
+ * @brief Shift out and latch the whole chain if an output changed since the last latch cycle
+ *
+ * @return E_OK when nothing was pending or the change is latched on return,
+ *         E_NOT_OK when it preempted a shift and will be latched by it
+ *
+ * @note Should be called once per main loop pass after the output changes of the pass
+ */
+Std_Return_Type IC_74hc595_Flush(void);
+
+/**
+ * @brief Get the output image of one device on the 74hc595 chain
+ *
+ * @param[in]  Device_Type  :Component
+ *
+ * @return last value posted for the stage
+ *
+ */
+uint8_t IC_74hc595_Get_Image(Device_Type Component);
+
 /**
  * @brief Get status of input selected IC mux 74LS151
  *
@@ -108,6 +220,7 @@ void IC_74hc595_Send_Data(uint8_t data, Device_Type Component);
  *
  * @return GPIO_PinState of Input line selected of IC 74LS151
  *
+ * @note Thread context only, the select lines are locked between the tasks
  */
 GPIO_PinState IC_74ls151(uint8_t Select_Input);
 
@@ -121,11 +234,16 @@ uint8_t DecToString(uint8_t *pData,uint32_t number);
 
 /**
  * @brief function use to delay in micro second
+ *
+ * @note The TIM2 counter is not touched, waits of TIMEBASE_SLEEP_THRESHOLD_US or more
+ *       put the core in sleep mode until the TIM2 channel 1 compare interrupt fires
  */
 void udelay(uint32_t us);
 
 /**
  * @brief function use to delay in mini second
+ *
+ * @note The core sleeps in WFI for the whole wait
  */
 void mdelay(uint32_t ms);
 
@@ -0,0 +1,188 @@
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+
+#include "main.h"
+#include <stdint.h>
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+/* Waits shorter than this are spun, longer ones sleep in WFI until the TIM2 compare wakes the core */
+#define TIMEBASE_SLEEP_THRESHOLD_US         (50U)
+
+/* Longest wait which can be expressed with a wrapping 32 bits deadline */
+#define TIMEBASE_MAX_WAIT_US                (0x7FFFFFFFUL)
+
+/* Timer prescaler giving a 1 MHz count from the timer kernel clock (PCLK, x2 when APB is divided) */
+#define TIMEBASE_PRESCALER(__CLOCK__)       (((__CLOCK__) / 1000000U) - 1U)
+
+/* Highest SPI1 bit rate accepted by the segment LCD driver */
+#define TIMEBASE_SPI_MAX_BITRATE            (8000000U)
+
+/* System clock in fast mode: HSI16 / PLLM 1 * PLLN 8 / PLLR 2, APB divided by 4 so PCLK stays
+ * at 16 MHz and the USART2 baud rate never has to be reprogrammed */
+#define TIMEBASE_FAST_CLOCK_HZ              (64000000U)
+/*==================================================================================================
+                                           CONSTANTS
+==================================================================================================*/
+extern TIM_HandleTypeDef htim1;
+extern TIM_HandleTypeDef htim2;
+extern SPI_HandleTypeDef hspi1;
+/*==================================================================================================
+*                                              ENUMS
+==================================================================================================*/
+typedef enum
+{
+    TIMEBASE_CLOCK_SLOW     = 0U,       /* 16 MHz HSI, PLL off */
+    TIMEBASE_CLOCK_FAST     = 1U        /* 64 MHz PLL, PCLK 16 MHz */
+} Timebase_Clock_Mode_Type;
+
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+/**
+ * @brief  This function uses to start the free running microsecond counter (TIM2)
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ *
+ * @note The counter is never reset afterwards, it wraps every 2^32 us (~71 minutes)
+ */
+void Timebase_Init(void);
+
+/**
+ * @brief  This function uses to get the current monotonic time
+ *
+ * @param[in]  None
+ *
+ * @retval uint32_t current time in us
+ *
+ * @note Safe to be called from thread and interrupt context
+ */
+uint32_t Timebase_Now(void);
+
+/**
+ * @brief  This function uses to compute the deadline lying us microseconds from now
+ *
+ * @param[in]  us  : time from now in us (up to TIMEBASE_MAX_WAIT_US)
+ *
+ * @retval uint32_t deadline
+ */
+uint32_t Timebase_Deadline_After(uint32_t us);
+
+/**
+ * @brief  This function uses to check whether a deadline has been reached
+ *
+ * @param[in]  Deadline  : deadline returned by Timebase_Deadline_After
+ *
+ * @retval uint8_t 1 if the deadline is reached, 0 otherwise
+ *
+ * @note The comparison is wrap safe as long as the deadline is less than TIMEBASE_MAX_WAIT_US away
+ */
+uint8_t Timebase_Expired(uint32_t Deadline);
+
+/**
+ * @brief  This function uses to get the time elapsed since a timestamp
+ *
+ * @param[in]  Start  : timestamp returned by Timebase_Now
+ *
+ * @retval uint32_t elapsed time in us
+ */
+uint32_t Timebase_Elapsed(uint32_t Start);
+
+/**
+ * @brief  This function uses to block until a deadline is reached
+ *
+ * @param[in]  Deadline  : deadline returned by Timebase_Deadline_After
+ *
+ * @retval void
+ *
+ * @note Long waits from thread context sleep in WFI and are woken by the TIM2 CC1 interrupt,
+ *       short waits and waits from interrupt context are spun without touching the compare channel.
+ *       A deadline already passed returns at once
+ */
+void Timebase_Wait_Until(uint32_t Deadline);
+
+/**
+ * @brief  This function uses to sleep until a deadline is reached or a wake flag is raised
+ *
+ * @param[in]  Deadline  : deadline returned by Timebase_Deadline_After
+ *             pWake     : flag raised from interrupt context, checked with interrupts masked
+ *                         before each WFI so a raise can not be missed
+ *
+ * @retval void
+ *
+ * @note Thread context only, the core sleeps in WFI like Timebase_Wait_Until
+ */
+void Timebase_Sleep_Until(uint32_t Deadline, const volatile uint8_t* pWake);
+
+/**
+ * @brief  This function uses to add time which passed while TIM2 was stopped
+ *
+ * @param[in]  us  : time to add to the counter
+ *
+ * @retval void
+ *
+ * @note For Stop mode, measured by the RTC. CC1 and CC2 are moved by the same amount so a
+ *       pending compare still fires after the time it had left
+ */
+void Timebase_Advance(uint32_t us);
+
+/**
+ * @brief  This function uses to switch the system clock between slow and fast mode
+ *
+ * @param[in]  Mode  : TIMEBASE_CLOCK_SLOW
+ *                     TIMEBASE_CLOCK_FAST
+ *
+ * @retval void
+ *
+ * @note Timer prescalers and the SPI1 bit rate are retuned so all us timing and the
+ *       segment LCD bus keep their rate, the monotonic counter value is preserved
+ */
+void Timebase_Set_Clock_Mode(Timebase_Clock_Mode_Type Mode);
+
+/**
+ * @brief  This function uses to get the current clock mode
+ *
+ * @param[in]  None
+ *
+ * @retval Timebase_Clock_Mode_Type
+ */
+Timebase_Clock_Mode_Type Timebase_Get_Clock_Mode(void);
+
+/**
+ * @brief  This function uses to derive TIM1/TIM2 prescalers and SPI1 bit rate from the current clocks
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ */
+void Timebase_Update_Prescalers(void);
+
+/**
+ * @brief  This function uses to get the APB clock (PCLK) frequency
+ *
+ * @param[in]  None
+ *
+ * @retval uint32_t : Hz
+ *
+ * @note HAL free equivalent of HAL_RCC_GetPCLK1Freq
+ */
+uint32_t Timebase_Get_Pclk(void);
+
+#endif /* TIMEBASE_H */
@@ -0,0 +1,146 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+
+#include "main.h"
+#include <stdint.h>
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+/* Set to 1U (project define or here) to record driver enter/exit events, 0U compiles every hook out */
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE                        (0U)
+#endif
+
+/* Number of records kept in RAM, must be a power of 2 (8 bytes each) */
+#ifndef TRACE_BUFFER_SIZE
+#define TRACE_BUFFER_SIZE                   (128U)
+#endif
+
+/* "TRC1" marker so a debugger script can validate the buffer */
+#define TRACE_MAGIC                         (0x31435254UL)
+
+#if (TRACE_ENABLE == 1U)
+#define TRACE_ENTER(__ID__)                 Trace_Record((__ID__), TRACE_EVENT_ENTER, 0U)
+#define TRACE_EXIT(__ID__)                  Trace_Record((__ID__), TRACE_EVENT_EXIT, 0U)
+#define TRACE_SPAN_ENTER(__ID__, __DATA__)  Trace_Record((__ID__), TRACE_EVENT_ENTER, (uint16_t)(__DATA__))
+#define TRACE_INSTANT(__ID__, __DATA__)     Trace_Record((__ID__), TRACE_EVENT_INSTANT, (uint16_t)(__DATA__))
+#else
+#define TRACE_ENTER(__ID__)
+#define TRACE_EXIT(__ID__)
+#define TRACE_SPAN_ENTER(__ID__, __DATA__)
+#define TRACE_INSTANT(__ID__, __DATA__)
+#endif
+/*==================================================================================================
+                                           CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                              ENUMS
+==================================================================================================*/
+/**
+ * @brief Traced functions, the order is the numbering used in the dump
+ */
+typedef enum
+{
+    TRACE_ID_SHIFT_OUT                  = 0U,   /* IC_74hc595 */
+    TRACE_ID_595_SEND_DATA              = 1U,   /* IC_74hc595_Transaction */
+    TRACE_ID_LCD_FRAME_TRANSFER         = 2U,   /* Lcd_Frame_Transfer */
+    TRACE_ID_LCD_SEGMENT_DISPLAY_APP    = 3U,   /* Lcd_Segment_Display_App */
+    TRACE_ID_KEYPAD_SCAN                = 4U,   /* Keypad_Scan */
+    TRACE_ID_CONFIG_SWITCH              = 5U,   /* Config_Switch_Get_Value */
+    TRACE_ID_LCD_ENABLE                 = 6U,   /* lcd_enable */
+    TRACE_ID_LCD_PUT_CHAR               = 7U,   /* Lcd_Put_Char */
+    TRACE_ID_595_LATCH                  = 8U,   /* STCP pulse, data = keypad byte << 8 | LCD byte */
+    TRACE_ID_SPI_TRANSFER               = 9U,   /* SPI1 bytes queued, data = first byte << 8 | length */
+    TRACE_ID_LCD_SCE                    = 10U,  /* SCE pin level, data = 0/1 */
+    TRACE_ID_WAIT                       = 11U,  /* Timebase_Wait_Until span, data = requested us (saturated) */
+    TRACE_ID_KEYPAD_ROW                 = 12U,  /* Row sample, data = col << 8 | row << 4 | pin state */
+    TRACE_ID_LCD_COMMAND                = 13U,  /* HD44780 instruction, data = command */
+    TRACE_ID_BOOT                       = 14U,  /* Boot milestone, data = 0 first segment frame, 1 HD44780 ready */
+    TRACE_ID_EVENT                      = 15U,  /* Event_Dispatch, data = event id << 8 | low byte of the data */
+    TRACE_ID_COUNT                      = 16U
+} Trace_Id_Type;
+
+typedef enum
+{
+    TRACE_EVENT_ENTER   = 0U,
+    TRACE_EVENT_EXIT    = 1U,
+    TRACE_EVENT_INSTANT = 2U
+} Trace_Event_Type;
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+/**
+ * @brief One trace record, 8 bytes little endian
+ */
+typedef struct
+{
+    uint32_t Timestamp;         /* TIM2 monotonic time in us */
+    uint8_t  Id;                /* Trace_Id_Type */
+    uint8_t  Event;             /* Trace_Event_Type */
+    uint16_t Data;              /* Event argument, 0 for enter/exit */
+} Trace_Record_Type;
+
+/**
+ * @brief RAM ring buffer, Head counts every record written so Head & (Size - 1) is the next slot
+ *        and min(Head, Size) records are valid
+ */
+typedef struct
+{
+    uint32_t Magic;
+    uint32_t Size;
+    volatile uint32_t Head;
+    Trace_Record_Type Record[TRACE_BUFFER_SIZE];
+} Trace_Buffer_Type;
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+#if (TRACE_ENABLE == 1U)
+extern Trace_Buffer_Type Trace_Buffer;
+#endif
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+/**
+ * @brief  This function uses to clear the trace buffer
+ *
+ * @param[in]  None
+ *
+ * @retval void
+ */
+void Trace_Init(void);
+
+/**
+ * @brief  This function uses to append one record to the trace buffer
+ *
+ * @param[in]  Id     : Trace_Id_Type
+ * @param[in]  Event  : Trace_Event_Type
+ * @param[in]  Data   : event argument
+ *
+ * @retval void
+ *
+ * @note Safe to be called from thread and interrupt context, the oldest record is overwritten
+ */
+void Trace_Record(uint8_t Id, uint8_t Event, uint16_t Data);
+
+/**
+ * @brief  This function uses to print the trace buffer as text, oldest record first
+ *
+ * @param[in]  pPutChar  : function writing one character to the output channel
+ *
+ * @retval void
+ *
+ * @note Format, one item per line:
+ *       "N,<id>,<name>"              name of each trace id
+ *       "R,<timestamp>,<id>,<E|X|I>,<data>"  one record
+ */
+void Trace_Dump(void (*pPutChar)(uint8_t Data));
+
+#endif /* TRACE_H */
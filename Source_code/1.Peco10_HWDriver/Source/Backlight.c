@@ -0,0 +1,202 @@
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+#include "Backlight.h"
+#include "Settings.h"
+#include "Event_bus.h"
+/*==================================================================================================
+                                           CONSTANTS
+==================================================================================================*/
+/**
+ * @brief Compare value for each level, round(999 * (level / 100) ^ 2.2), at least 1 above level 0
+ */
+static const uint16_t BacklightGamma[BACKLIGHT_LEVEL_MAX + 1U] =
+{
+       0U,    1U,    1U,    1U,    1U,    1U,    2U,    3U,    4U,    5U,
+       6U,    8U,    9U,   11U,   13U,   15U,   18U,   20U,   23U,   26U,
+      29U,   32U,   36U,   39U,   43U,   47U,   52U,   56U,   61U,   66U,
+      71U,   76U,   81U,   87U,   93U,   99U,  106U,  112U,  119U,  126U,
+     133U,  141U,  148U,  156U,  164U,  172U,  181U,  190U,  199U,  208U,
+     217U,  227U,  237U,  247U,  258U,  268U,  279U,  290U,  301U,  313U,
+     325U,  337U,  349U,  362U,  374U,  387U,  400U,  414U,  428U,  442U,
+     456U,  470U,  485U,  500U,  515U,  531U,  546U,  562U,  578U,  595U,
+     611U,  628U,  646U,  663U,  681U,  699U,  717U,  735U,  754U,  773U,
+     792U,  812U,  832U,  852U,  872U,  892U,  913U,  934U,  956U,  977U,
+     999U
+};
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+#define BACKLIGHT_SET_DUTY(__LEVEL__)           (BACKLIGHT_TIM->CCR1 = BacklightGamma[(__LEVEL__)])
+#define BACKLIGHT_FADE_IT_ENABLE()              (BACKLIGHT_TIM->DIER |= TIM_DIER_UIE)
+#define BACKLIGHT_FADE_IT_DISABLE()             (BACKLIGHT_TIM->DIER &= ~TIM_DIER_UIE)
+/*==================================================================================================
+*                                              ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  LOCAL VARIABLE DECLARATIONS
+==================================================================================================*/
+/* Level chosen by the user */
+static uint8_t BacklightUserLevel = BACKLIGHT_DEFAULT_LEVEL;
+/* Level currently output, updated by the fade interrupt */
+static volatile uint8_t BacklightLevel = 0U;
+
+/* Fade state, owned by the interrupt while the update interrupt is enabled */
+static uint8_t BacklightFadeFrom = 0U;
+static uint8_t BacklightFadeTo = 0U;
+static uint16_t BacklightFadeDuration = 0U;
+static uint16_t BacklightFadeTick = 0U;
+
+static uint32_t BacklightIdleDeadline = 0U;
+static uint8_t BacklightDimmed = 0U;
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+static void Backlight_On_Key(const Event_Type* pEvent);
+
+/*==================================================================================================
+*                                         LOCAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief  This function uses to restart the idle timeout on EVENT_KEY_PRESSED
+ */
+static void Backlight_On_Key(const Event_Type* pEvent)
+{
+    (void)pEvent;
+    Backlight_Activity();
+}
+
+/*==================================================================================================
+*                                        GLOBAL FUNCTIONS
+==================================================================================================*/
+void Backlight_Init(void)
+{
+    uint32_t Level;
+
+    if((Settings_Get(SETTINGS_KEY_BACKLIGHT_LEVEL, &Level) == E_OK) && (Level <= BACKLIGHT_LEVEL_MAX))
+    {
+        BacklightUserLevel = (uint8_t)Level;
+    }
+    BacklightLevel = 0U;
+    BACKLIGHT_SET_DUTY(0U);
+#if (PECO10_LL_BUILD == 1U)
+    BACKLIGHT_TIM->CCER |= TIM_CCER_CC1E;
+    BACKLIGHT_TIM->BDTR |= TIM_BDTR_MOE;
+    BACKLIGHT_TIM->CR1 |= TIM_CR1_CEN;
+#else
+    HAL_TIM_PWM_Start(BACKLIGHT_TIMER, BACKLIGHT_CHANNEL);
+#endif
+    BacklightIdleDeadline = Timebase_Deadline_After(BACKLIGHT_IDLE_TIMEOUT_US);
+    BacklightDimmed = 0U;
+    Backlight_Fade_To(BacklightUserLevel, BACKLIGHT_FADE_MS);
+    (void)Event_Subscribe(EVENT_KEY_PRESSED, Backlight_On_Key);
+}
+
+void Backlight_Set_Level(uint8_t Level)
+{
+    if(Level > BACKLIGHT_LEVEL_MAX)
+    {
+        Level = BACKLIGHT_LEVEL_MAX;
+    }
+    BacklightUserLevel = Level;
+    (void)Settings_Set(SETTINGS_KEY_BACKLIGHT_LEVEL, Level);
+    Backlight_Activity();
+    Backlight_Fade_To(Level, BACKLIGHT_FADE_MS);
+}
+
+uint8_t Backlight_Get_Level(void)
+{
+    return BacklightUserLevel;
+}
+
+void Backlight_Fade_To(uint8_t Level, uint16_t DurationMs)
+{
+    if(Level > BACKLIGHT_LEVEL_MAX)
+    {
+        Level = BACKLIGHT_LEVEL_MAX;
+    }
+    /* Take the fade state back from the interrupt */
+    BACKLIGHT_FADE_IT_DISABLE();
+    if((DurationMs == 0U) || (Level == BacklightLevel))
+    {
+        BacklightLevel = Level;
+        BACKLIGHT_SET_DUTY(Level);
+        return;
+    }
+    BacklightFadeFrom = BacklightLevel;
+    BacklightFadeTo = Level;
+    BacklightFadeDuration = DurationMs;
+    BacklightFadeTick = 0U;
+    BACKLIGHT_TIM->SR = ~TIM_SR_UIF;
+    BACKLIGHT_FADE_IT_ENABLE();
+}
+
+void Backlight_Activity(void)
+{
+    BacklightIdleDeadline = Timebase_Deadline_After(BACKLIGHT_IDLE_TIMEOUT_US);
+    if(BacklightDimmed != 0U)
+    {
+        BacklightDimmed = 0U;
+        Backlight_Fade_To(BacklightUserLevel, 0U);
+    }
+}
+
+void Backlight_Task(void)
+{
+    if((BacklightDimmed == 0U) && (Timebase_Expired(BacklightIdleDeadline) != 0U))
+    {
+        BacklightDimmed = 1U;
+        if(BacklightUserLevel > BACKLIGHT_DIM_LEVEL)
+        {
+            Backlight_Fade_To(BACKLIGHT_DIM_LEVEL, BACKLIGHT_DIM_FADE_MS);
+        }
+    }
+}
+
+/*==================================================================================================
+*                                        INTERUPT HANDLER FUNCTIONS
+==================================================================================================*/
+void Backlight_Timer_IRQHandler(void)
+{
+    int32_t Span;
+
+    BacklightFadeTick++;
+    if(BacklightFadeTick >= BacklightFadeDuration)
+    {
+        BacklightLevel = BacklightFadeTo;
+        BACKLIGHT_FADE_IT_DISABLE();
+    }
+    else
+    {
+        Span = (int32_t)BacklightFadeTo - (int32_t)BacklightFadeFrom;
+        BacklightLevel = (uint8_t)((int32_t)BacklightFadeFrom
+                                   + ((Span * (int32_t)BacklightFadeTick) / (int32_t)BacklightFadeDuration));
+    }
+    /* CCR1 is preloaded, the new duty starts with the next period */
+    BACKLIGHT_SET_DUTY(BacklightLevel);
+}
+
+#if (PECO10_LL_BUILD == 0U)
+/**
+ * @brief  This function is TIM period elapsed callback, one fade step per TIM1 PWM period
+ */
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+    if(htim == BACKLIGHT_TIMER)
+    {
+        Backlight_Timer_IRQHandler();
+    }
+}
+#endif
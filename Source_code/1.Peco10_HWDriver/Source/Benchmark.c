@@ -0,0 +1,206 @@
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+#include "Benchmark.h"
+#include "Lcd_character.h"
+#include "Lcd_segment.h"
+#include "Timebase.h"
+/*==================================================================================================
+                                           CONSTANTS
+==================================================================================================*/
+/* Line 0 of each page, 12 characters at most, in the order of Benchmark_Path */
+static const char* const BenchmarkNames[] =
+{
+    "595 chain",
+    "Lcd_Put_Char",
+    "Segment app",
+    "Keypad_Scan",
+    "Idle loop"
+};
+
+/* Nothing changes, the chain is still shifted out and latched */
+static const uint8_t BenchmarkChainNone[IC_74HC595_STAGES] = {0U};
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+#define BENCHMARK_PATHS                         (sizeof(BenchmarkNames) / sizeof(BenchmarkNames[0]))
+
+/* Width of the character LCD */
+#define BENCHMARK_LINE_LENGTH                   (16U)
+/* Longest time shown, 6 digits */
+#define BENCHMARK_SHOWN_MAX_US                  (999999UL)
+#define BENCHMARK_SHOWN(__US__)                 (((__US__) > BENCHMARK_SHOWN_MAX_US) ? BENCHMARK_SHOWN_MAX_US : (unsigned long)(__US__))
+/*==================================================================================================
+*                                              ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+typedef struct
+{
+    uint32_t AverageUs;
+    uint32_t MaxUs;
+} Benchmark_Result_Type;
+/*==================================================================================================
+*                                  LOCAL VARIABLE DECLARATIONS
+==================================================================================================*/
+static Benchmark_Pass_Type BenchmarkIdlePass;
+static Benchmark_Result_Type BenchmarkResults[BENCHMARK_PATHS];
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                         LOCAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief  This function uses to run the path shown on page Path once
+ */
+static void Benchmark_Path(uint8_t Path)
+{
+    uint8_t Key[3];
+
+    switch(Path)
+    {
+        case 0U:
+            (void)IC_74hc595_Write_Chain(BenchmarkChainNone, BenchmarkChainNone);
+            break;
+        case 1U:
+            Lcd_Put_Char((uint8_t)' ');
+            break;
+        case 2U:
+            /* Up to the end of the SPI transfer, not only its start */
+            Lcd_Segment_Display_App();
+            while(Lcd_Segment_Is_Busy() != 0U)
+            {
+            }
+            break;
+        case 3U:
+            (void)Keypad_Scan(Key);
+            break;
+        default:
+            BenchmarkIdlePass();
+            break;
+    }
+}
+
+/**
+ * @brief  This function uses to wait until no key is pushed
+ */
+static void Benchmark_Wait_Release(void)
+{
+    while(Keypad_Scan_Matrix() != 0U)
+    {
+        mdelay(BENCHMARK_KEY_POLL_MS);
+    }
+}
+
+/**
+ * @brief  This function uses to wait for the next push, returns the keys pushed
+ */
+static uint16_t Benchmark_Wait_Key(void)
+{
+    uint16_t Keys;
+
+    Benchmark_Wait_Release();
+    do
+    {
+        mdelay(BENCHMARK_KEY_POLL_MS);
+        Keys = Keypad_Scan_Matrix();
+    }while(Keys == 0U);
+    return Keys;
+}
+
+/**
+ * @brief  This function uses to time each path BENCHMARK_RUNS times with TIM2
+ */
+static void Benchmark_Measure(void)
+{
+    uint32_t Start;
+    uint32_t Elapsed;
+    uint32_t Sum;
+    uint8_t Path;
+    uint8_t Run;
+
+    /* Same core clock as the main loop work */
+    Timebase_Set_Clock_Mode(TIMEBASE_CLOCK_FAST);
+    /* Blanked after a while on the result pages, it would send nothing */
+    Lcd_Segment_Resume();
+    for(Path = 0U; Path < BENCHMARK_PATHS; Path++)
+    {
+        Sum = 0U;
+        BenchmarkResults[Path].MaxUs = 0U;
+        for(Run = 0U; Run < BENCHMARK_RUNS; Run++)
+        {
+            /* Interrupts stay enabled, the maximum includes those landing in the path */
+            Start = Timebase_Now();
+            Benchmark_Path(Path);
+            Elapsed = Timebase_Elapsed(Start);
+            Sum += Elapsed;
+            if(Elapsed > BenchmarkResults[Path].MaxUs)
+            {
+                BenchmarkResults[Path].MaxUs = Elapsed;
+            }
+        }
+        BenchmarkResults[Path].AverageUs = Sum / BENCHMARK_RUNS;
+    }
+}
+
+/**
+ * @brief  This function uses to show the result of one path, both lines are written in full
+ */
+static void Benchmark_Show(uint8_t Path)
+{
+    char Line[BENCHMARK_LINE_LENGTH + 8U];
+
+    (void)snprintf(Line, sizeof(Line), "%-12s%u/%u", BenchmarkNames[Path], (unsigned int)(Path + 1U),
+                   (unsigned int)BENCHMARK_PATHS);
+    Lcd_Put_String(0U, 0U, (uint8_t*)Line);
+    (void)snprintf(Line, sizeof(Line), "%6lu/%6lu us", BENCHMARK_SHOWN(BenchmarkResults[Path].AverageUs),
+                   BENCHMARK_SHOWN(BenchmarkResults[Path].MaxUs));
+    Lcd_Put_String(1U, 0U, (uint8_t*)Line);
+}
+/*==================================================================================================
+*                                         GLOBAL FUNCTIONS
+==================================================================================================*/
+uint8_t Benchmark_Is_Requested(void)
+{
+    return (Keypad_Scan_Matrix() == BENCHMARK_CHORD) ? 1U : 0U;
+}
+
+void Benchmark_Run(Benchmark_Pass_Type pIdlePass)
+{
+    uint16_t Keys = BENCHMARK_KEY_RERUN;
+    uint8_t Page = 0U;
+
+    BenchmarkIdlePass = pIdlePass;
+    do
+    {
+        if((Keys & BENCHMARK_KEY_RERUN) != 0U)
+        {
+            Lcd_Clear();
+            Lcd_Put_String(0U, 0U, (uint8_t*)"Benchmark");
+            /* A key held would change the keypad and idle loop timings */
+            Benchmark_Wait_Release();
+            Benchmark_Measure();
+            Page = 0U;
+        }
+        else
+        {
+            Page = (uint8_t)((Page + 1U) % BENCHMARK_PATHS);
+        }
+        Benchmark_Show(Page);
+        Keys = Benchmark_Wait_Key();
+    }while((Keys & BENCHMARK_KEY_EXIT) == 0U);
+
+    /* Keypad_Task would report X once back in the main loop */
+    Benchmark_Wait_Release();
+}
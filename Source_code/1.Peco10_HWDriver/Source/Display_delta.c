@@ -0,0 +1,203 @@
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+#include "Display_delta.h"
+#include "Lcd_segment.h"
+#include "Lcd_character.h"
+/*==================================================================================================
+                                           CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+#define DISPLAY_DELTA_CRC_POLYNOMIAL            (0x04C11DB7U)
+#define DISPLAY_DELTA_CRC_INIT                  (0xFFFFFFFFU)
+
+/* Byte of the batch at an offset from its start */
+#define DELTA_BYTE(__OFFSET__)                  (pRing[(uint16_t)(Start + (__OFFSET__)) & Mask])
+/*==================================================================================================
+*                                              ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  LOCAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+static uint32_t Display_Delta_Crc(const uint8_t* pRing, uint16_t Mask, uint16_t Start, uint16_t Length);
+static Std_Return_Type Display_Delta_Walk(const uint8_t* pRing, uint16_t Mask, uint16_t Start, uint16_t Length,
+                                          uint8_t Apply);
+
+/*==================================================================================================
+*                                         LOCAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief  This function uses to compute the CRC-32 of a ring buffer range with the CRC unit
+ *
+ * @param[in]  pRing   : ring buffer base
+ *             Mask    : ring size - 1
+ *             Start   : index of the first byte
+ *             Length  : number of bytes
+ *
+ * @retval     CRC-32/MPEG-2 of the range
+ */
+static uint32_t Display_Delta_Crc(const uint8_t* pRing, uint16_t Mask, uint16_t Start, uint16_t Length)
+{
+    uint16_t i;
+
+    __HAL_RCC_CRC_CLK_ENABLE();
+    CRC->POL = DISPLAY_DELTA_CRC_POLYNOMIAL;
+    CRC->INIT = DISPLAY_DELTA_CRC_INIT;
+    /* 32 bit polynomial, no input/output reversal, load INIT */
+    CRC->CR = CRC_CR_RESET;
+    for(i = 0U; i < Length; i++)
+    {
+        /* Byte access feeds 8 bits per write */
+        *(__IO uint8_t*)&CRC->DR = DELTA_BYTE(i);
+    }
+    return CRC->DR;
+}
+
+/**
+ * @brief  This function uses to parse the records of a batch, and apply them if requested
+ *
+ * @param[in]  pRing   : ring buffer base
+ *             Mask    : ring size - 1
+ *             Start   : index of the first record byte
+ *             Length  : records length, CRC excluded
+ *             Apply   : 0 to only check the records, otherwise update the displays
+ *
+ * @retval     E_OK when every record is well formed and in range
+ */
+static Std_Return_Type Display_Delta_Walk(const uint8_t* pRing, uint16_t Mask, uint16_t Start, uint16_t Length,
+                                          uint8_t Apply)
+{
+    uint16_t Pos = 0U;
+    uint16_t RecordLength;
+    uint8_t Line;
+    uint8_t Offset;
+    uint8_t Count;
+    uint8_t i;
+    uint32_t Value;
+
+    while(Pos < Length)
+    {
+        switch(DELTA_BYTE(Pos))
+        {
+            case DISPLAY_DELTA_RAM_PATCH:
+                if((Pos + 3U) > Length)
+                {
+                    return E_NOT_OK;
+                }
+                Offset = DELTA_BYTE(Pos + 1U);
+                Count = DELTA_BYTE(Pos + 2U);
+                RecordLength = 3U + Count;
+                if(((Pos + RecordLength) > Length) || (((uint16_t)Offset + Count) > LCD_SEGMENT_RAM_SIZE))
+                {
+                    return E_NOT_OK;
+                }
+                if(Apply != 0U)
+                {
+                    (void)Lcd_Segment_Put_Ram(Offset, pRing, Mask, (uint16_t)(Start + Pos + 3U), Count);
+                }
+                break;
+            case DISPLAY_DELTA_NUMBER:
+                RecordLength = 7U;
+                if(((Pos + RecordLength) > Length) || (DELTA_BYTE(Pos + 1U) >= LCD_SEGMENT_LINES)
+                    || ((DELTA_BYTE(Pos + 2U) & DISPLAY_DELTA_NUMBER_DECIMAL_MASK) >= LCD_SEGMENT_COLS))
+                {
+                    return E_NOT_OK;
+                }
+                if(Apply != 0U)
+                {
+                    Value = (uint32_t)DELTA_BYTE(Pos + 3U) | ((uint32_t)DELTA_BYTE(Pos + 4U) << 8)
+                          | ((uint32_t)DELTA_BYTE(Pos + 5U) << 16) | ((uint32_t)DELTA_BYTE(Pos + 6U) << 24);
+                    /* An overflowing value shows as dashes, the rest of the batch still applies */
+                    (void)Lcd_Segment_Put_Number(DELTA_BYTE(Pos + 1U), (int32_t)Value,
+                                                 DELTA_BYTE(Pos + 2U) & DISPLAY_DELTA_NUMBER_DECIMAL_MASK,
+                                                 ((DELTA_BYTE(Pos + 2U) & DISPLAY_DELTA_NUMBER_COMMA) != 0U) ? ',' : '.');
+                }
+                break;
+            case DISPLAY_DELTA_INDICATOR:
+                RecordLength = 2U;
+                if((Pos + RecordLength) > Length)
+                {
+                    return E_NOT_OK;
+                }
+                if(Apply != 0U)
+                {
+                    Lcd_Segment_Put_Indicator(DELTA_BYTE(Pos + 1U));
+                }
+                break;
+            case DISPLAY_DELTA_CHARACTER_CELLS:
+                if((Pos + 4U) > Length)
+                {
+                    return E_NOT_OK;
+                }
+                Line = DELTA_BYTE(Pos + 1U);
+                Offset = DELTA_BYTE(Pos + 2U);
+                Count = DELTA_BYTE(Pos + 3U);
+                RecordLength = 4U + Count;
+                if(((Pos + RecordLength) > Length) || (Line >= LCD_CHARACTER_LINES)
+                    || (((uint16_t)Offset + Count) > LCD_CHARACTER_COLS))
+                {
+                    return E_NOT_OK;
+                }
+                if((Apply != 0U) && (Count != 0U))
+                {
+                    Lcd_Set_Cursor(Line, Offset);
+                    for(i = 0U; i < Count; i++)
+                    {
+                        Lcd_Put_Char(DELTA_BYTE(Pos + 4U + i));
+                    }
+                }
+                break;
+            default:
+                /* Unknown record, its length cannot be known */
+                return E_NOT_OK;
+        }
+        Pos += RecordLength;
+    }
+    return E_OK;
+}
+
+/*==================================================================================================
+*                                        GLOBAL FUNCTIONS
+==================================================================================================*/
+Std_Return_Type Display_Delta_Apply(const uint8_t* pRing, uint16_t Mask, uint16_t Start, uint16_t Length)
+{
+    uint16_t RecordsLength;
+    uint32_t Crc;
+
+    if(Length < DISPLAY_DELTA_CRC_SIZE)
+    {
+        return E_NOT_OK;
+    }
+    RecordsLength = Length - DISPLAY_DELTA_CRC_SIZE;
+    Crc = (uint32_t)DELTA_BYTE(RecordsLength) | ((uint32_t)DELTA_BYTE(RecordsLength + 1U) << 8)
+        | ((uint32_t)DELTA_BYTE(RecordsLength + 2U) << 16) | ((uint32_t)DELTA_BYTE(RecordsLength + 3U) << 24);
+    if(Display_Delta_Crc(pRing, Mask, Start, RecordsLength) != Crc)
+    {
+        return E_NOT_OK;
+    }
+    if(Display_Delta_Walk(pRing, Mask, Start, RecordsLength, 0U) != E_OK)
+    {
+        return E_NOT_OK;
+    }
+    (void)Display_Delta_Walk(pRing, Mask, Start, RecordsLength, 1U);
+    return E_OK;
+}
@@ -0,0 +1,169 @@
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+#include "Event_bus.h"
+/*==================================================================================================
+                                           CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+#define EVENT_QUEUE_MASK                        (EVENT_QUEUE_SIZE - 1U)
+/*==================================================================================================
+*                                              ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  LOCAL VARIABLE DECLARATIONS
+==================================================================================================*/
+/* Subscribers of each event, EventSubscriberCount[id] entries used */
+static Event_Handler_Type EventSubscribers[EVENT_COUNT][EVENT_MAX_SUBSCRIBERS];
+static uint8_t EventSubscriberCount[EVENT_COUNT];
+
+/* Event ring, written under masked interrupts by Event_Publish */
+static Event_Type EventQueue[EVENT_QUEUE_SIZE];
+static uint8_t EventHead = 0U;
+static uint8_t EventTail = 0U;
+/* Queued events */
+static volatile uint8_t EventPending = 0U;
+/* Bit n set when EVENT_LEVEL_MASK event n is pending */
+static volatile uint32_t EventFlags = 0U;
+/* Given by each Event_Publish, taken by Event_Wait_Until */
+static Os_Semaphore_Type EventWake;
+static uint32_t EventDropped = 0U;
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+static void Event_Deliver(const Event_Type* pEvent);
+
+/*==================================================================================================
+*                                         LOCAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief  This function uses to call the subscribers of one event
+ */
+static void Event_Deliver(const Event_Type* pEvent)
+{
+    uint8_t i;
+
+    TRACE_INSTANT(TRACE_ID_EVENT, ((uint16_t)pEvent->Id << 8) | (uint8_t)pEvent->Data);
+    for(i = 0U; i < EventSubscriberCount[pEvent->Id]; i++)
+    {
+        EventSubscribers[pEvent->Id][i](pEvent);
+    }
+}
+
+/*==================================================================================================
+*                                         GLOBAL FUNCTIONS
+==================================================================================================*/
+void Event_Init(void)
+{
+    Os_Semaphore_Init(&EventWake);
+}
+
+Std_Return_Type Event_Subscribe(Event_Id_Type Id, Event_Handler_Type Handler)
+{
+    if((Id >= EVENT_COUNT) || (Handler == NULL) || (EventSubscriberCount[Id] >= EVENT_MAX_SUBSCRIBERS))
+    {
+        return E_NOT_OK;
+    }
+    EventSubscribers[Id][EventSubscriberCount[Id]] = Handler;
+    EventSubscriberCount[Id]++;
+    return E_OK;
+}
+
+Std_Return_Type Event_Publish(Event_Id_Type Id, uint32_t Data)
+{
+    uint32_t Primask;
+    Std_Return_Type Status = E_OK;
+
+    Primask = __get_PRIMASK();
+    __disable_irq();
+    if(((EVENT_LEVEL_MASK >> Id) & 1U) != 0U)
+    {
+        EventFlags |= 1UL << Id;
+    }
+    else if(EventPending >= EVENT_QUEUE_SIZE)
+    {
+        EventDropped++;
+        Status = E_NOT_OK;
+    }
+    else
+    {
+        EventQueue[EventHead].Id = Id;
+        EventQueue[EventHead].Data = Data;
+        EventHead = (EventHead + 1U) & EVENT_QUEUE_MASK;
+        EventPending++;
+    }
+    __set_PRIMASK(Primask);
+    Os_Semaphore_Give(&EventWake);
+    return Status;
+}
+
+uint8_t Event_Dispatch(void)
+{
+    Event_Type Event;
+    uint32_t Primask;
+    uint32_t Flags;
+    uint8_t Count = 0U;
+    uint8_t Id;
+
+    while((EventPending != 0U) || (EventFlags != 0U))
+    {
+        Primask = __get_PRIMASK();
+        __disable_irq();
+        Flags = EventFlags;
+        EventFlags = 0U;
+        __set_PRIMASK(Primask);
+        Event.Data = 0U;
+        for(Id = 0U; Id < (uint8_t)EVENT_COUNT; Id++)
+        {
+            if(((Flags >> Id) & 1U) != 0U)
+            {
+                Event.Id = (Event_Id_Type)Id;
+                Event_Deliver(&Event);
+                Count++;
+            }
+        }
+
+        while(EventPending != 0U)
+        {
+            __disable_irq();
+            Event = EventQueue[EventTail];
+            EventTail = (EventTail + 1U) & EVENT_QUEUE_MASK;
+            EventPending--;
+            __set_PRIMASK(Primask);
+
+            Event_Deliver(&Event);
+            Count++;
+        }
+    }
+    return Count;
+}
+
+void Event_Wait_Until(uint32_t Deadline)
+{
+    uint32_t Remaining = Deadline - Timebase_Now();
+
+    if((EventPending == 0U) && (EventFlags == 0U) && ((int32_t)Remaining > 0))
+    {
+        (void)Os_Semaphore_Take(&EventWake, Remaining);
+    }
+}
+
+uint32_t Event_Get_Dropped_Count(void)
+{
+    return EventDropped;
+}
@@ -5,6 +5,7 @@
 * 3) internal and external interfaces from this unit
 ==================================================================================================*/
 #include "Keypad.h"
+#include "Event_bus.h"
 
 /*==================================================================================================
                                            CONSTANTS
@@ -21,6 +22,9 @@
 
 #define KEYPAD_CONNECTED            0
 #define KEYPAD_NOT_CONNECTED        1
+
+/* Config switch value never read, the first Config_Switch_Task publishes */
+#define CONFIG_SWITCH_UNKNOWN       0xFFU
 /*==================================================================================================
 *                                              ENUMS
 ==================================================================================================*/
@@ -32,6 +36,10 @@
 /*==================================================================================================
 *                                  LOCAL VARIABLE DECLARATIONS
 ==================================================================================================*/
+/* Key name seen by the last Keypad_Task, 0 when no key is pushed */
+static uint32_t KeypadLastKey = 0U;
+/* Switch value seen by the last Config_Switch_Task */
+static uint8_t ConfigSwitchLast = CONFIG_SWITCH_UNKNOWN;
 
 /*==================================================================================================
 *                                  GLOBAL VARIABLE DECLARATIONS
@@ -75,6 +83,8 @@ Keypad_Button_Type Keypad_Scan(uint8_t *pkey)
     Keypad_Button_Type eKeypad_Status = BUTTON_UNKNOWN;
     uint8_t row,col;
     uint8_t KeypadLoss = KEYPAD_NOT_CONNECTED;
+    GPIO_PinState RowState;
+    TRACE_ENTER(TRACE_ID_KEYPAD_SCAN);
     row = col = 0;
     *pkey = DUMMY_DATA;
     
@@ -86,7 +96,9 @@ Keypad_Button_Type Keypad_Scan(uint8_t *pkey)
         for(row=0;row<NUM_ROWS;row++)
         {
             /* Get row state sequentially */
-            if(GPIO_PIN_RESET == Read_Row(row))
+            RowState = Read_Row(row);
+            TRACE_INSTANT(TRACE_ID_KEYPAD_ROW, ((uint16_t)col << 8) | (row << 4) | RowState);
+            if(GPIO_PIN_RESET == RowState)
             {
                 //*pkey = KeyMap[(row * NUM_ROWS ) + col];
                 strcpy((char*)pkey,KeyMap[row][col]);
@@ -101,20 +113,78 @@ Keypad_Button_Type Keypad_Scan(uint8_t *pkey)
             }
         }
     }
+    /* Columns are no longer deselected as a side effect of LCD writes */
+    Release_Col();
     if(KeypadLoss == KEYPAD_NOT_CONNECTED)
         eKeypad_Status = KEYPAD_LOSS;
+    TRACE_EXIT(TRACE_ID_KEYPAD_SCAN);
     return eKeypad_Status;
 }
 
+uint16_t Keypad_Scan_Matrix(void)
+{
+    uint16_t Keys = 0U;
+    uint8_t row,col;
+
+    TRACE_ENTER(TRACE_ID_KEYPAD_SCAN);
+    for(col=0;col<NUM_COLS;col++)
+    {
+        Select_Col(col);
+        for(row=0;row<NUM_ROWS;row++)
+        {
+            if(GPIO_PIN_RESET == Read_Row(row))
+            {
+                Keys |= KEYPAD_KEY_BIT(row, col);
+            }
+        }
+    }
+    Release_Col();
+    TRACE_EXIT(TRACE_ID_KEYPAD_SCAN);
+    /* Every row reads low without the keypad */
+    return (Keys == (uint16_t)((1UL << (NUM_ROWS * NUM_COLS)) - 1UL)) ? 0U : Keys;
+}
+
 uint8_t Config_Switch_Get_Value(void)
 {
     uint8_t Switch_value = 0;
     uint8_t Mux_input_status = 0;
+    TRACE_ENTER(TRACE_ID_CONFIG_SWITCH);
     for (uint8_t i =0; i < 4 ; i++)
     {
         /* select 74LS151 input pin from D4 to D7 to get Switch data*/
         Mux_input_status = (uint8_t)IC_74ls151(i + MUX_D4_SEL);
         Switch_value = Switch_value | (Mux_input_status << i);
     }
+    TRACE_EXIT(TRACE_ID_CONFIG_SWITCH);
     return Switch_value;
 }
+
+void Keypad_Task(void)
+{
+    uint8_t Key[3] = {0U, 0U, 0U};
+    uint32_t Name = 0U;
+
+    if(Keypad_Scan(Key) == KEYPAD_PUSHED)
+    {
+        Name = (uint32_t)Key[0] | ((uint32_t)Key[1] << 8);
+    }
+    if(Name != KeypadLastKey)
+    {
+        KeypadLastKey = Name;
+        if(Name != 0U)
+        {
+            (void)Event_Publish(EVENT_KEY_PRESSED, Name);
+        }
+    }
+}
+
+void Config_Switch_Task(void)
+{
+    uint8_t Value = Config_Switch_Get_Value();
+
+    if(Value != ConfigSwitchLast)
+    {
+        ConfigSwitchLast = Value;
+        (void)Event_Publish(EVENT_SWITCH_CHANGED, Value);
+    }
+}
@@ -12,6 +12,10 @@
 /*==================================================================================================
                                        DEFINES AND MACROS
 ==================================================================================================*/
+/* LCD stage of the 74HC595 chain */
+#define LCD_595_DATA_MASK           ((uint8_t)0x0FU)    /* Q0-Q3 D4-D7 */
+#define LCD_595_RS                  ((uint8_t)0x10U)    /* Q4 */
+#define LCD_595_E                   ((uint8_t)0x20U)    /* Q5 */
 
 /*==================================================================================================
 *                                              ENUMS
@@ -28,8 +32,18 @@
 /*==================================================================================================
 *                                  GLOBAL VARIABLE DECLARATIONS
 ==================================================================================================*/
-/* Variable to store pin state of the 74HC595 */
-static volatile uint8_t Current_74HC595_Data_Out = 0U;
+/* Power-on sequence state and end of its current wait */
+static Lcd_Init_State_Type LcdInitState = LCD_INIT_DONE;
+static uint32_t LcdInitDeadline = 0U;
+
+/* Marquee: shifts done since the home position (0 to 39), step period and next step */
+static uint8_t LcdMarqueeActive = 0U;
+static uint8_t LcdMarqueeShift = 0U;
+static uint32_t LcdMarqueeStep = 0U;
+static uint32_t LcdMarqueeDeadline = 0U;
+
+/* One command or character on the 74HC595 stage at a time, a string or a marquee line in one go */
+static Os_Mutex_Type LcdCharacterMutex;
 /*==================================================================================================
 *                                       FUNCTION PROTOTYPES
 ==================================================================================================*/
@@ -49,10 +63,7 @@ static void lcd_enable(void);
 static void Lcd_Instruction_Enable(void)
 {
     /* Write 0 logic to Q4 Pin of 74HC595 */
-    Current_74HC595_Data_Out &= ~((uint8_t)0x10U);
-    /* Shift data to 74HC595 */
-    IC_74hc595_Send_Data(Current_74HC595_Data_Out,LCD_CHARACTER);
-    
+    (void)IC_74hc595_Transaction(LCD_CHARACTER, LCD_595_RS, 0U);
 }
 
 /**
@@ -63,9 +74,7 @@ static void Lcd_Instruction_Enable(void)
 static void Lcd_Instruction_Disable(void)
 {
     /* Write 1 logic to Q4 Pin of 74HC595 */
-    Current_74HC595_Data_Out |= ((uint8_t)0x10U);
-    /* Shift data to 74HC595 */
-    IC_74hc595_Send_Data(Current_74HC595_Data_Out,LCD_CHARACTER);
+    (void)IC_74hc595_Transaction(LCD_CHARACTER, LCD_595_RS, LCD_595_RS);
 }
     
 /**
@@ -76,9 +85,7 @@ static void Lcd_Instruction_Disable(void)
 static void Lcd_Enable_Pin_Low(void)
 {
     /* Write 0 logic to Q5 Pin of 74HC595 */
-    Current_74HC595_Data_Out &= ~((uint8_t)0x20U);
-    /* Shift data to 74HC595 */
-    IC_74hc595_Send_Data(Current_74HC595_Data_Out,LCD_CHARACTER);
+    (void)IC_74hc595_Transaction(LCD_CHARACTER, LCD_595_E, 0U);
 }
 
 /**
@@ -89,19 +96,19 @@ static void Lcd_Enable_Pin_Low(void)
 static void Lcd_Enable_Pin_High(void)
 {
     /* Write 1 logic to Q5 Pin of 74HC595 */
-    Current_74HC595_Data_Out |= ((uint8_t)0x20U);
-    /* Shift data to 74HC595 */
-    IC_74hc595_Send_Data(Current_74HC595_Data_Out,LCD_CHARACTER);
+    (void)IC_74hc595_Transaction(LCD_CHARACTER, LCD_595_E, LCD_595_E);
 }
 
 static void lcd_enable(void)
 {
+    TRACE_ENTER(TRACE_ID_LCD_ENABLE);
     /*EN = 1*/
     Lcd_Enable_Pin_High();
     udelay(10);
     /*EN = 0*/
     Lcd_Enable_Pin_Low();
     udelay(100);
+    TRACE_EXIT(TRACE_ID_LCD_ENABLE);
 }
 
 /**
@@ -111,24 +118,22 @@ static void lcd_enable(void)
  */
 static void Lcd_Write_4bits(uint8_t data)
 {
-    /* Clear 4 bits low (Q0-Q1-Q2-Q3) */
-	Current_74HC595_Data_Out &= (uint8_t)0xF0U;
-    /* Override the 4 bit low */
-    Current_74HC595_Data_Out |= (data & (uint8_t)0x0FU);
-	/* Shift data to 74HC595 */
-    
-    IC_74hc595_Send_Data(Current_74HC595_Data_Out,LCD_CHARACTER);
+    /* Override the 4 bit low (Q0-Q1-Q2-Q3), RS and E are kept */
+    (void)IC_74hc595_Transaction(LCD_CHARACTER, LCD_595_DATA_MASK, data);
     
 	lcd_enable();
 }
 static void lcd_send_command(uint8_t cmd)
 {
+    TRACE_INSTANT(TRACE_ID_LCD_COMMAND, cmd);
+    Os_Mutex_Lock(&LcdCharacterMutex);
     /*RS = 0, for LCD command*/
     Lcd_Instruction_Enable();
     /*Send 4 bit High of command*/
     Lcd_Write_4bits(cmd >> 4);
     /*Send 4 bit Low of command*/
     Lcd_Write_4bits(cmd & 0xF);
+    Os_Mutex_Unlock(&LcdCharacterMutex);
 }
 
 /*
@@ -137,12 +142,16 @@ static void lcd_send_command(uint8_t cmd)
  * */
 void Lcd_Put_Char(uint8_t data)
 {
+    TRACE_ENTER(TRACE_ID_LCD_PUT_CHAR);
+    Os_Mutex_Lock(&LcdCharacterMutex);
     /*RS = 1, for LCD user data*/
     Lcd_Instruction_Disable();
     /*Send 4 bit High of command*/
     Lcd_Write_4bits(data >> 4);
     /*Send 4 bit Low of command*/
     Lcd_Write_4bits(data & 0xF);
+    Os_Mutex_Unlock(&LcdCharacterMutex);
+    TRACE_EXIT(TRACE_ID_LCD_PUT_CHAR);
 }
 
 /*==================================================================================================
@@ -152,35 +161,80 @@ void Lcd_Put_Char(uint8_t data)
 
 void Lcd_Init_4bits_Mode(void)
 {
-    //1. Do the lcd initialization
-    mdelay(40);
-    /*RS = 0, for LCD command*/
-    Lcd_Instruction_Enable();
-    
-    Lcd_Write_4bits(0x3U);
-    mdelay(5);
-    Lcd_Write_4bits(0x3U);
-    udelay(150);
-    
-    Lcd_Write_4bits(0x3U);
-    Lcd_Write_4bits(0x2U);
-    
-    //function set command
-    lcd_send_command(LCD_CMD_4DL_2N_5X8F);
-    udelay(40);
-    
-    //Display on cursor on
-    lcd_send_command(LCD_CMD_DON_CURON);
-    udelay(40);
-    
-    Lcd_Clear();
-    //entry mode set
-    lcd_send_command(LCD_CMD_INCADD);
-    udelay(40);
+    Lcd_Init_4bits_Mode_Start();
+    while(Lcd_Init_4bits_Mode_Poll() != LCD_INIT_DONE)
+    {
+        Timebase_Wait_Until(LcdInitDeadline);
+    }
+}
+
+void Lcd_Init_4bits_Mode_Start(void)
+{
+    Os_Mutex_Init(&LcdCharacterMutex);
+    //1. Do the lcd initialization, 40 ms after power on
+    LcdInitDeadline = Timebase_Deadline_After(40000U);
+    LcdInitState = LCD_INIT_POWER_ON;
+}
+
+Lcd_Init_State_Type Lcd_Init_4bits_Mode_Poll(void)
+{
+    if((LcdInitState == LCD_INIT_DONE) || (Timebase_Expired(LcdInitDeadline) == 0U))
+    {
+        return LcdInitState;
+    }
+    switch(LcdInitState)
+    {
+        case LCD_INIT_POWER_ON:
+            /*RS = 0, for LCD command*/
+            Lcd_Instruction_Enable();
+            Lcd_Write_4bits(0x3U);
+            LcdInitDeadline = Timebase_Deadline_After(5000U);
+            LcdInitState = LCD_INIT_WAKE_UP_1;
+            break;
+        case LCD_INIT_WAKE_UP_1:
+            Lcd_Write_4bits(0x3U);
+            LcdInitDeadline = Timebase_Deadline_After(150U);
+            LcdInitState = LCD_INIT_WAKE_UP_2;
+            break;
+        case LCD_INIT_WAKE_UP_2:
+            Lcd_Write_4bits(0x3U);
+            Lcd_Write_4bits(0x2U);
+            
+            //function set command
+            lcd_send_command(LCD_CMD_4DL_2N_5X8F);
+            udelay(40);
+            
+            //Display on cursor on
+            lcd_send_command(LCD_CMD_DON_CURON);
+            udelay(40);
+            
+            /*clear needs more than 1.52ms, waited in the next step*/
+            lcd_send_command(LCD_CMD_DIS_CLEAR);
+            LcdInitDeadline = Timebase_Deadline_After(2000U);
+            LcdInitState = LCD_INIT_CLEAR;
+            break;
+        case LCD_INIT_CLEAR:
+            //entry mode set
+            lcd_send_command(LCD_CMD_INCADD);
+            udelay(40);
+            LcdInitState = LCD_INIT_DONE;
+            break;
+        default:
+            break;
+    }
+    return LcdInitState;
+}
+
+uint32_t Lcd_Init_4bits_Mode_Get_Deadline(void)
+{
+    return LcdInitDeadline;
 }
 
 void Lcd_Clear(void)
 {
+    /* Clear also cancels the display shift */
+    LcdMarqueeActive = 0U;
+    LcdMarqueeShift = 0U;
     lcd_send_command(LCD_CMD_DIS_CLEAR);
     /*delay more than 1.52ms for command process 
     * Check page num24 of datasheet
@@ -191,6 +245,7 @@ void Lcd_Clear(void)
 void Lcd_Put_String(uint8_t line, uint8_t offset, uint8_t *pString)
 {
     uint8_t count=0;
+    Os_Mutex_Lock(&LcdCharacterMutex);
     Lcd_Set_Cursor(line,offset);
     do
     {
@@ -199,6 +254,7 @@ void Lcd_Put_String(uint8_t line, uint8_t offset, uint8_t *pString)
         if((offset + (16*line) + count) == 16)
             Lcd_Set_Cursor(1,0);
     }while(*pString != '\0');
+    Os_Mutex_Unlock(&LcdCharacterMutex);
 }
 
 void Lcd_Set_Cursor(uint8_t line, uint8_t offset)
@@ -238,8 +294,68 @@ void Lcd_Turn_Off_Cursor(void)
     udelay(40);
 }
 
+void Lcd_Marquee_Start(uint8_t line, const uint8_t *pString, uint16_t StepMs)
+{
+    uint8_t i;
+    uint8_t Length = 0U;
+
+    if(line > 1U)
+    {
+        return;
+    }
+    Lcd_Marquee_Stop();
+    while((Length < LCD_CHARACTER_DDRAM_COLS) && (pString[Length] != '\0'))
+    {
+        Length++;
+    }
+    /* Fill the whole DDRAM line, the blanks after the text separate two passes */
+    Os_Mutex_Lock(&LcdCharacterMutex);
+    Lcd_Set_Cursor(line, 0U);
+    for(i = 0U; i < LCD_CHARACTER_DDRAM_COLS; i++)
+    {
+        Lcd_Put_Char((i < Length) ? pString[i] : (uint8_t)' ');
+    }
+    Os_Mutex_Unlock(&LcdCharacterMutex);
+    if(Length <= LCD_CHARACTER_COLS)
+    {
+        return;
+    }
+    LcdMarqueeStep = (uint32_t)((StepMs != 0U) ? StepMs : LCD_MARQUEE_DEFAULT_STEP_MS) * 1000U;
+    LcdMarqueeDeadline = Timebase_Deadline_After(LcdMarqueeStep);
+    LcdMarqueeActive = 1U;
+}
+
+void Lcd_Marquee_Stop(void)
+{
+    LcdMarqueeActive = 0U;
+    if(LcdMarqueeShift != 0U)
+    {
+        LcdMarqueeShift = 0U;
+        lcd_send_command(LCD_CMD_DIS_RETURN_HOME);
+        /*delay more than 1.52ms for command process 
+        * Check page num24 of datasheet
+        */
+        mdelay(2);
+    }
+}
+
+void Lcd_Marquee_Task(void)
+{
+    if((LcdMarqueeActive == 0U) || (Timebase_Expired(LcdMarqueeDeadline) == 0U))
+    {
+        return;
+    }
+    LcdMarqueeDeadline = Timebase_Deadline_After(LcdMarqueeStep);
+    lcd_send_command(LCD_CMD_SHIFT_LEFT);
+    /* After 40 shifts the display is back home by itself */
+    LcdMarqueeShift++;
+    if(LcdMarqueeShift >= LCD_CHARACTER_DDRAM_COLS)
+    {
+        LcdMarqueeShift = 0U;
+    }
+}
 
 uint8_t Lcd_Character_Get_Current_74HC595_Value(void)
 {
-    return Current_74HC595_Data_Out;
+    return IC_74hc595_Get_Image(LCD_CHARACTER);
 }
@@ -5,6 +5,8 @@
 * 3) internal and external interfaces from this unit
 ==================================================================================================*/
 #include "Lcd_segment.h"
+#include "Ll_init.h"
+#include "stm32g0xx_ll_dma.h"
 /*==================================================================================================
                                            CONSTANTS
 ==================================================================================================*/
@@ -36,8 +38,8 @@ static const uint8_t DisplayDataFont2[26U] =
     0x30U,   /* COMMA */    0x20U    /* DOT */
 };
 
-/* Lcd device code number */
-static const uint8_t LcdDeviceCode = LCD_DEVICE_CODE;
+/* SCE pin and device code number of each driver */
+static const Lcd_Segment_Driver_Type LcdSegmentDrivers[LCD_SEGMENT_DRIVER_COUNT] = LCD_SEGMENT_DRIVER_CONFIG;
 
 /* Control data for the SPI frame DD=00 */
 static const uint8_t ControlData0[3U] = 
@@ -73,15 +75,34 @@ static const uint8_t ControlData3[4U] =
 /*==================================================================================================
                                        DEFINES AND MACROS
 ==================================================================================================*/
-#define LCD_CS_ENABLE()           HAL_GPIO_WritePin(SCE_PORT,SCE_PIN,GPIO_PIN_SET)
-#define LCD_CS_DISABLE()          HAL_GPIO_WritePin(SCE_PORT,SCE_PIN,GPIO_PIN_RESET)
+#define LCD_CS_ENABLE(__DRV__)    STD_GPIO_WRITE(LcdSegmentDrivers[__DRV__].CsPort,LcdSegmentDrivers[__DRV__].CsPin,GPIO_PIN_SET)
+#define LCD_CS_DISABLE(__DRV__)   STD_GPIO_WRITE(LcdSegmentDrivers[__DRV__].CsPort,LcdSegmentDrivers[__DRV__].CsPin,GPIO_PIN_RESET)
 //#define LCD_CS_ENABLING()         ((GPIOC->IDR)&(uint32_t)0x4000U)
-#define LCD_CS_ENABLING()         HAL_GPIO_ReadPin(SCE_PORT,SCE_PIN)
+#define LCD_CS_ENABLING(__DRV__)  STD_GPIO_READ(LcdSegmentDrivers[__DRV__].CsPort,LcdSegmentDrivers[__DRV__].CsPin)
+
+/* DMA1 channel 2 feeds the frames to SPI1 */
+#define LCD_DMA                       DMA1
+#define LCD_DMA_CHANNEL               LL_DMA_CHANNEL_2
 
 /* LCD driver Display off (Active Low level) */
 //#define LCD_DISPLAY_ENABLE()             HAL_GPIO_WritePin(GPIOC, GPIO_PIN_15, GPIO_PIN_SET)
 //#define LCD_DISPLAY_DISABLE()            HAL_GPIO_WritePin(GPIOC, GPIO_PIN_15, GPIO_PIN_RESET)
 
+/* ControlData0[2] bits, last byte of the DD=00 control data in the driver datasheet:
+ * b7 FC, b6 OC, b5 SC, b4 BU, b3..2 fixed 0, b1..0 DD.
+ * SC 1: segments off, BU 1: power saving (oscillator stopped, outputs at VSS) */
+#define LCD_CONTROL_SC                0x20U
+#define LCD_CONTROL_BU                0x10U
+
+/* Display RAM bytes of one line, line row starts at LCD_LINE_RAM_START(row) in the RAM of its driver */
+#define LCD_LINE_RAM_BYTES            9U
+#define LCD_LINE_RAM_START(__ROW__)   ((LCD_DISPLAY_RAM_SIZE * ((__ROW__) / LCD_SEGMENT_ROWS)) + 19U - \
+                                       (9U * ((__ROW__) % LCD_SEGMENT_ROWS)))
+
+/* Bit LCD_FRAME_BIT(d, n) set when LcdSpiFrames[d][n] must be sent, frames go out in bit order */
+#define LCD_FRAME_BIT(__DRV__, __N__) (1UL << (((__DRV__) * LCD_FRAME_COUNT) + (__N__)))
+#define LCD_FRAME_ALL                 ((1UL << (LCD_FRAME_COUNT * LCD_SEGMENT_DRIVER_COUNT)) - 1UL)
+
 #define DOT_COMMA_MASK_FONT1          0x11U
 #define DOT_COMMA_MASK_FONT2          0x30U
 /*==================================================================================================
@@ -91,6 +112,17 @@ static const uint8_t ControlData3[4U] =
 /*==================================================================================================
 *                                  STRUCTURES AND OTHER TYPEDEFS
 ==================================================================================================*/
+/**
+ * @brief Lcd_Segment_Marquee_Type, scrolling text of one line
+ */
+typedef struct
+{
+    uint8_t Text[LCD_SEGMENT_MARQUEE_SIZE];     /* Source text, read modulo Length */
+    uint8_t Length;                             /* Text length, 0 when the line does not scroll */
+    uint8_t Start;                              /* Index of the leftmost shown character */
+    uint32_t Step;                              /* Step period in us */
+    uint32_t Deadline;                          /* Next step */
+} Lcd_Segment_Marquee_Type;
 
 /*==================================================================================================
 *                                  LOCAL VARIABLE DECLARATIONS
@@ -102,14 +134,68 @@ static const uint8_t ControlData3[4U] =
 /* 14 characters Data display for each line (include comma or dot)*/
 static uint8_t LcdSegmentDataDisplay[LCD_SEGMENT_ROWS][LCD_SEGMENT_COLS << 1U];
 
-/* LCD display RAM */
-static uint8_t LcdDisplayRam[LCD_DISPLAY_RAM_SIZE];
+/* LCD display RAM of all drivers */
+static uint8_t LcdDisplayRam[LCD_SEGMENT_RAM_SIZE];
+
+/* Duration of the last refresh in us, and start of the refresh in progress */
+static uint32_t LcdRefreshTime = 0U;
+static uint32_t LcdRefreshStart = 0U;
+
+/* SPI frames built from LcdDisplayRam by the last Lcd_Segment_Display_App, resent as is on resume */
+static uint8_t LcdSpiFrames[LCD_SEGMENT_DRIVER_COUNT][LCD_FRAME_COUNT][LCD_FRAME_LENGTH];
+
+#if (LCD_SEGMENT_SPI_HAL == 1U)
+/* Driver whose SCE the SPI callback releases */
+static uint8_t LcdCsDriver = 0U;
+#else
+/* DMA chain: frames still to send (LCD_FRAME_BIT), frame on the bus, chain running */
+static uint32_t LcdChainFrames = 0U;
+static uint8_t LcdChainFrame = 0U;
+static volatile uint8_t LcdChainBusy = 0U;
+/* Given at the end of each chain */
+static Os_Semaphore_Type LcdChainDone;
+#endif
+
+/* Display RAM, cursor, blink and marquee state and the SPI bus, taken by each public function */
+static Os_Mutex_Type LcdSegmentMutex;
+
+/* Driver in power saving mode, the frames are still built but not sent */
+static uint8_t LcdPowerSave = 0U;
+
+/* Blinking indicators and digit segments, hidden while LcdBlinkOff is set */
+static uint8_t LcdBlinkIndicators = 0U;
+static uint8_t LcdBlinkDigits[LCD_SEGMENT_LINES];
+static uint8_t LcdBlinkMask[LCD_SEGMENT_LINES][LCD_LINE_RAM_BYTES];
+
+/* Edit cursor per line: col (0 none), decimal point bits shown and dot/comma bits hidden */
+static uint8_t LcdCursorCol[LCD_SEGMENT_LINES];
+static uint8_t LcdCursorMask[LCD_SEGMENT_LINES][LCD_LINE_RAM_BYTES];
+static uint8_t LcdDotMask[LCD_SEGMENT_LINES][LCD_LINE_RAM_BYTES];
+
+/* Scrolling lines */
+static Lcd_Segment_Marquee_Type LcdMarquee[LCD_SEGMENT_LINES];
+
+static uint8_t LcdBlinkOff = 0U;
+static uint32_t LcdBlinkPeriod = LCD_SEGMENT_BLINK_DEFAULT_MS * 1000U;
+static uint32_t LcdBlinkDeadline = 0U;
 
 /*==================================================================================================
 *                                       FUNCTION PROTOTYPES
 ==================================================================================================*/
-static void Lcd_Frame_Transfer(uint8_t* LcdSpiFrame);
+static void Lcd_Frame_Transfer(uint8_t Driver, const uint8_t* pLcdSpiFrame);
+#if (LCD_SEGMENT_SPI_HAL == 0U)
+static void Lcd_Spi_Write(const uint8_t* pData, uint8_t len);
+static void Lcd_Segment_Chain_Next(void);
+#endif
+static void Lcd_Segment_Wait(void);
 static void Lcd_Segment_Prepare_Display_Ram(uint8_t col, uint8_t row, uint8_t Data);
+static uint32_t Lcd_Segment_Build_Frames(void);
+static void Lcd_Segment_Send_Frames(uint32_t Frames);
+static void Lcd_Segment_Cell_Mask(uint8_t col, uint8_t row, uint8_t Data, uint8_t* pMask);
+static void Lcd_Segment_Shown_Ram(uint8_t* pRam);
+static uint8_t Lcd_Segment_Is_Blinking(void);
+static void Lcd_Segment_Blink_Start(void);
+static void Lcd_Segment_Marquee_Show(uint8_t line);
 static uint8_t FontPosition(uint8_t character);
 
 /*==================================================================================================
@@ -207,67 +293,68 @@ static uint8_t FontPosition(uint8_t character)
 static void Lcd_Segment_Prepare_Display_Ram(uint8_t col, uint8_t row, uint8_t Data)
 {
     uint8_t FontPos = FontPosition(Data);
+    uint8_t* pLine = &LcdDisplayRam[LCD_LINE_RAM_START(row)];
     switch (col)
     {
         case 7:
             if((Data == '.')||(Data == ','))
             {
-                LcdDisplayRam[19 - 9*row] = (LcdDisplayRam[19 - 9*row] & ~DOT_COMMA_MASK_FONT1) | DisplayDataFont1[FontPos];
+                pLine[0U] = (pLine[0U] & ~DOT_COMMA_MASK_FONT1) | DisplayDataFont1[FontPos];
             }else{
-                LcdDisplayRam[19 - 9*row] = (LcdDisplayRam[19 - 9*row] & 0xF1) | (DisplayDataFont1[FontPos] >> 4);
-                LcdDisplayRam[20 - 9*row] = (LcdDisplayRam[20 - 9*row] & 0xF) | (DisplayDataFont1[FontPos] << 4);
+                pLine[0U] = (pLine[0U] & 0xF1) | (DisplayDataFont1[FontPos] >> 4);
+                pLine[1U] = (pLine[1U] & 0xF) | (DisplayDataFont1[FontPos] << 4);
             }
             break;
         case 6:
             if((Data == '.')||(Data == ','))
             {
-                LcdDisplayRam[20 - 9*row] = (LcdDisplayRam[20 - 9*row] & ~(DOT_COMMA_MASK_FONT2 >> 4)) | (DisplayDataFont2[FontPos] >> 4);
+                pLine[1U] = (pLine[1U] & ~(DOT_COMMA_MASK_FONT2 >> 4)) | (DisplayDataFont2[FontPos] >> 4);
             }else{
-                LcdDisplayRam[21 - 9*row] = DisplayDataFont2[FontPos];
+                pLine[2U] = DisplayDataFont2[FontPos];
             }
             break;
         case 5:
             if((Data == '.')||(Data == ','))
             {
-                LcdDisplayRam[21 - 9*row] = (LcdDisplayRam[21 - 9*row] & ~(DOT_COMMA_MASK_FONT1 >> 4)) | (DisplayDataFont1[FontPos] >> 4);
-                LcdDisplayRam[22 - 9*row] = (LcdDisplayRam[22 - 9*row] & ~(DOT_COMMA_MASK_FONT1 << 4)) | (DisplayDataFont1[FontPos] << 4);
+                pLine[2U] = (pLine[2U] & ~(DOT_COMMA_MASK_FONT1 >> 4)) | (DisplayDataFont1[FontPos] >> 4);
+                pLine[3U] = (pLine[3U] & ~(DOT_COMMA_MASK_FONT1 << 4)) | (DisplayDataFont1[FontPos] << 4);
             }else{
-                LcdDisplayRam[22 - 9*row] = (LcdDisplayRam[22 - 9*row] & 0x10U) | DisplayDataFont1[FontPos];
+                pLine[3U] = (pLine[3U] & 0x10U) | DisplayDataFont1[FontPos];
             }
             break;
         case 4:
             if((Data == '.')||(Data == ','))
             {
-                LcdDisplayRam[23 - 9*row] = (LcdDisplayRam[23 - 9*row] & ~DOT_COMMA_MASK_FONT2) | DisplayDataFont2[FontPos];
+                pLine[4U] = (pLine[4U] & ~DOT_COMMA_MASK_FONT2) | DisplayDataFont2[FontPos];
             }else{
-                LcdDisplayRam[23 - 9*row] = (LcdDisplayRam[23 - 9*row] & 0xF0) | (DisplayDataFont2[FontPos] >> 4);
-                LcdDisplayRam[24 - 9*row] = (LcdDisplayRam[24 - 9*row] & 0xF) | (DisplayDataFont2[FontPos] << 4);
+                pLine[4U] = (pLine[4U] & 0xF0) | (DisplayDataFont2[FontPos] >> 4);
+                pLine[5U] = (pLine[5U] & 0xF) | (DisplayDataFont2[FontPos] << 4);
             }
             break;
         case 3:
             if((Data == '.')||(Data == ','))
             {
-                LcdDisplayRam[24 - 9*row] = (LcdDisplayRam[24 - 9*row] & ~DOT_COMMA_MASK_FONT1) | DisplayDataFont1[FontPos];
+                pLine[5U] = (pLine[5U] & ~DOT_COMMA_MASK_FONT1) | DisplayDataFont1[FontPos];
             }else{
-                LcdDisplayRam[24 - 9*row] = (LcdDisplayRam[24 - 9*row] & 0xF1) | (DisplayDataFont1[FontPos] >> 4);
-                LcdDisplayRam[25 - 9*row] = (LcdDisplayRam[25 - 9*row] & 0xF) | (DisplayDataFont1[FontPos] << 4);
+                pLine[5U] = (pLine[5U] & 0xF1) | (DisplayDataFont1[FontPos] >> 4);
+                pLine[6U] = (pLine[6U] & 0xF) | (DisplayDataFont1[FontPos] << 4);
             }
             break;
         case 2:
             if((Data == '.')||(Data == ','))
             {
-                LcdDisplayRam[25 - 9*row] = (LcdDisplayRam[25 - 9*row] & ~(DOT_COMMA_MASK_FONT2 >> 4)) | (DisplayDataFont2[FontPos] >> 4);
+                pLine[6U] = (pLine[6U] & ~(DOT_COMMA_MASK_FONT2 >> 4)) | (DisplayDataFont2[FontPos] >> 4);
             }else{
-                LcdDisplayRam[26 - 9*row] = DisplayDataFont2[FontPos];
+                pLine[7U] = DisplayDataFont2[FontPos];
             }
             break;
         case 1:
             if((Data == '.')||(Data == ','))
             {
-                LcdDisplayRam[26 - 9*row] = (LcdDisplayRam[26 - 9*row] & ~(DOT_COMMA_MASK_FONT1 >> 4)) | (DisplayDataFont1[FontPos] >> 4);
-                LcdDisplayRam[27 - 9*row] = (LcdDisplayRam[27 - 9*row] & ~(DOT_COMMA_MASK_FONT1 << 4)) | (DisplayDataFont1[FontPos] << 4);
+                pLine[7U] = (pLine[7U] & ~(DOT_COMMA_MASK_FONT1 >> 4)) | (DisplayDataFont1[FontPos] >> 4);
+                pLine[8U] = (pLine[8U] & ~(DOT_COMMA_MASK_FONT1 << 4)) | (DisplayDataFont1[FontPos] << 4);
             }else{
-                LcdDisplayRam[27 - 9*row] = (LcdDisplayRam[27 - 9*row] & 0x10) | DisplayDataFont1[FontPos];
+                pLine[8U] = (pLine[8U] & 0x10) | DisplayDataFont1[FontPos];
             }
             break;
         default:
@@ -275,23 +362,379 @@ static void Lcd_Segment_Prepare_Display_Ram(uint8_t col, uint8_t row, uint8_t Da
     }
 }
 
+#if (LCD_SEGMENT_SPI_HAL == 0U)
+/**
+ * @brief  This function uses to transmit bytes on SPI1 and wait for the end of the last bit
+ *
+ * @param[in]  pData    : bytes to transmit
+ *             len      : number of bytes
+ *
+ * @retval     void
+ */
+static void Lcd_Spi_Write(const uint8_t* pData, uint8_t len)
+{
+    uint8_t i = 0U;
+
+    /* Timebase_Update_Prescalers disables SPI1 while changing BR */
+    LCD_SPI->CR1 |= SPI_CR1_SPE;
+    while(i < len)
+    {
+        if((LCD_SPI->SR & SPI_SR_TXE) != 0U)
+        {
+            /* 8 bit access, one byte per FIFO entry */
+            *(__IO uint8_t*)&LCD_SPI->DR = pData[i];
+            i++;
+        }
+    }
+    /* FIFO drained and last byte shifted out */
+    while(((LCD_SPI->SR & SPI_SR_FTLVL) != 0U) || ((LCD_SPI->SR & SPI_SR_BSY) != 0U));
+    /* Received bytes are not used, flush them and clear the overrun */
+    while((LCD_SPI->SR & SPI_SR_FRLVL) != 0U)
+    {
+        (void)*(__IO uint8_t*)&LCD_SPI->DR;
+    }
+    (void)LCD_SPI->SR;
+}
+#endif
+
 /**
  * @brief  This function uses to send each frame data to display lcd through spi transmit
  *
- * @param[in]  pLcdSpiFrame    : Data frame to transmit
+ * @param[in]  Driver          : driver index
+ *             pLcdSpiFrame    : Data frame to transmit
  *
  * @retval     void
  */
-static void Lcd_Frame_Transfer(uint8_t* pLcdSpiFrame)
+static void Lcd_Frame_Transfer(uint8_t Driver, const uint8_t* pLcdSpiFrame)
 {
+    const uint8_t* pDeviceCode = &LcdSegmentDrivers[Driver].DeviceCode;
+
+    TRACE_ENTER(TRACE_ID_LCD_FRAME_TRANSFER);
     /*disable SCE Lcd pin*/
-    LCD_CS_DISABLE();
+    LCD_CS_DISABLE(Driver);
+    TRACE_INSTANT(TRACE_ID_LCD_SCE, 0U);
     /*Transmit first 8 bit device code*/
-    HAL_SPI_Transmit(LCD_SPI_INSTANCE,(uint8_t*)&LcdDeviceCode, 1U, 10);
-    LCD_CS_ENABLE();
+    TRACE_INSTANT(TRACE_ID_SPI_TRANSFER, ((uint16_t)*pDeviceCode << 8) | 1U);
+#if (LCD_SEGMENT_SPI_HAL == 1U)
+    HAL_SPI_Transmit(LCD_SPI_INSTANCE,(uint8_t*)pDeviceCode, 1U, 10);
+#else
+    Lcd_Spi_Write(pDeviceCode, 1U);
+#endif
+    LCD_CS_ENABLE(Driver);
+    TRACE_INSTANT(TRACE_ID_LCD_SCE, 1U);
+    TRACE_INSTANT(TRACE_ID_SPI_TRANSFER, ((uint16_t)pLcdSpiFrame[0] << 8) | LCD_FRAME_LENGTH);
+#if (LCD_SEGMENT_SPI_HAL == 1U)
+    LcdCsDriver = Driver;
     HAL_SPI_Transmit_IT(LCD_SPI_INSTANCE,(uint8_t*)pLcdSpiFrame, LCD_FRAME_LENGTH);
     /*Waiting transmition is done, Lcd SCE will be set to LOW by SPI callback*/
-    while(LCD_CS_ENABLING());
+    while(LCD_CS_ENABLING(Driver));
+#else
+    Lcd_Spi_Write(pLcdSpiFrame, LCD_FRAME_LENGTH);
+    LCD_CS_DISABLE(Driver);
+    TRACE_INSTANT(TRACE_ID_LCD_SCE, 0U);
+#endif
+    TRACE_EXIT(TRACE_ID_LCD_FRAME_TRANSFER);
+}
+
+#if (LCD_SEGMENT_SPI_HAL == 0U)
+/**
+ * @brief  This function uses to start the next frame of the DMA chain, or end the chain
+ *
+ * @param[in]  None
+ *
+ * @retval     void
+ *
+ * @note Runs from Lcd_Segment_Send_Frames for the first frame, then from the DMA interrupt.
+ *       The device code byte is written by the CPU, the 12 frame bytes by the DMA
+ */
+static void Lcd_Segment_Chain_Next(void)
+{
+    uint8_t Driver;
+    const uint8_t* pFrame;
+
+    if(LcdChainFrames == 0U)
+    {
+        /* Timebase_Update_Prescalers waits for TXDMAEN to clear before touching BR */
+        LCD_SPI->CR2 &= ~SPI_CR2_TXDMAEN;
+        LcdRefreshTime = Timebase_Elapsed(LcdRefreshStart);
+        LcdChainBusy = 0U;
+        Os_Semaphore_Give(&LcdChainDone);
+        return;
+    }
+    LcdChainFrame = 0U;
+    while((LcdChainFrames & (1UL << LcdChainFrame)) == 0U)
+    {
+        LcdChainFrame++;
+    }
+    LcdChainFrames &= ~(1UL << LcdChainFrame);
+    Driver = LcdChainFrame / LCD_FRAME_COUNT;
+    pFrame = LcdSpiFrames[Driver][LcdChainFrame % LCD_FRAME_COUNT];
+
+    TRACE_INSTANT(TRACE_ID_SPI_TRANSFER, ((uint16_t)LcdSegmentDrivers[Driver].DeviceCode << 8) | 1U);
+    Lcd_Spi_Write(&LcdSegmentDrivers[Driver].DeviceCode, 1U);
+    LCD_CS_ENABLE(Driver);
+    TRACE_INSTANT(TRACE_ID_LCD_SCE, 1U);
+    TRACE_INSTANT(TRACE_ID_SPI_TRANSFER, ((uint16_t)pFrame[0] << 8) | LCD_FRAME_LENGTH);
+    LL_DMA_DisableChannel(LCD_DMA, LCD_DMA_CHANNEL);
+    LL_DMA_SetMemoryAddress(LCD_DMA, LCD_DMA_CHANNEL, (uint32_t)pFrame);
+    LL_DMA_SetDataLength(LCD_DMA, LCD_DMA_CHANNEL, LCD_FRAME_LENGTH);
+    LL_DMA_EnableChannel(LCD_DMA, LCD_DMA_CHANNEL);
+}
+#endif
+
+/**
+ * @brief  This function uses to wait for the end of the DMA chain before the frames are touched
+ *
+ * @param[in]  None
+ *
+ * @retval     void
+ */
+static void Lcd_Segment_Wait(void)
+{
+#if (LCD_SEGMENT_SPI_HAL == 0U)
+    while(LcdChainBusy != 0U)
+    {
+        /* Sleeps, or lets the other tasks run, until the DMA interrupt ends the chain */
+        (void)Os_Semaphore_Take(&LcdChainDone, OS_WAIT_FOREVER);
+    }
+#endif
+}
+
+/**
+ * @brief  This function uses to collect the display RAM bits one character lights in a cell
+ *
+ * @param[in]      col    : col index [1-7]
+ *                 row    : line index [0-LCD_SEGMENT_LINES-1]
+ *                 Data   : character, '8' for every digit segment, '.' for the decimal point
+ * @param[in,out]  pMask  : line mask, LCD_LINE_RAM_BYTES bytes, the bits are ORed in
+ *
+ * @retval     void
+ */
+static void Lcd_Segment_Cell_Mask(uint8_t col, uint8_t row, uint8_t Data, uint8_t* pMask)
+{
+    uint8_t Saved[LCD_LINE_RAM_BYTES];
+    uint8_t* pLine = &LcdDisplayRam[LCD_LINE_RAM_START(row)];
+    uint8_t i;
+
+    /* Draw the character alone on the line and read back which bits it set */
+    memcpy(Saved, pLine, LCD_LINE_RAM_BYTES);
+    memset(pLine, 0U, LCD_LINE_RAM_BYTES);
+    Lcd_Segment_Prepare_Display_Ram(col, row, Data);
+    for(i = 0U; i < LCD_LINE_RAM_BYTES; i++)
+    {
+        pMask[i] |= pLine[i];
+    }
+    memcpy(pLine, Saved, LCD_LINE_RAM_BYTES);
+}
+
+/**
+ * @brief  This function uses to know whether an indicator or a digit blinks
+ *
+ * @param[in]  None
+ *
+ * @retval     uint8_t : 1 when something blinks
+ */
+static uint8_t Lcd_Segment_Is_Blinking(void)
+{
+    uint8_t row;
+    uint8_t Blinking = LcdBlinkIndicators;
+
+    for(row = 0U; row < LCD_SEGMENT_LINES; row++)
+    {
+        Blinking |= LcdBlinkDigits[row];
+    }
+    return (Blinking != 0U) ? 1U : 0U;
+}
+
+/**
+ * @brief  This function uses to start the blink phase when the first attribute is set
+ *
+ * @param[in]  None
+ *
+ * @retval     void
+ */
+static void Lcd_Segment_Blink_Start(void)
+{
+    if(Lcd_Segment_Is_Blinking() == 0U)
+    {
+        /* Start visible, first edge one half period from now */
+        LcdBlinkOff = 0U;
+        LcdBlinkDeadline = Timebase_Deadline_After(LcdBlinkPeriod);
+    }
+}
+
+/**
+ * @brief  This function uses to draw the 7 digit window of a scrolling line
+ *
+ * @param[in]  line  : LCD line index [0-LCD_SEGMENT_LINES-1]
+ *
+ * @retval     void
+ */
+static void Lcd_Segment_Marquee_Show(uint8_t line)
+{
+    Lcd_Segment_Marquee_Type* pMarquee = &LcdMarquee[line];
+    /* 7 digits, each may carry a dot or a comma */
+    uint8_t Window[LCD_SEGMENT_COLS << 1U];
+    uint8_t Count = 0U;
+    uint8_t Digits = 0U;
+    uint8_t Pos = pMarquee->Start;
+    uint8_t Data;
+
+    while(Count < sizeof(Window))
+    {
+        Data = (Pos < pMarquee->Length) ? pMarquee->Text[Pos] : (uint8_t)' ';
+        if((Data == '.') || (Data == ','))
+        {
+            /* Zero width, stays on the digit before it */
+            if(Count != 0U)
+            {
+                Window[Count++] = Data;
+            }
+        }
+        else if(Digits < LCD_SEGMENT_COLS)
+        {
+            Window[Count++] = Data;
+            Digits++;
+        }
+        else
+        {
+            break;
+        }
+        /* The text is followed by LCD_SEGMENT_COLS blanks before it starts again */
+        Pos = (Pos + 1U < pMarquee->Length + LCD_SEGMENT_COLS) ? (Pos + 1U) : 0U;
+    }
+    Lcd_Segment_Put_Data_Ring(line, Window, LCD_SEGMENT_LINEAR_MASK, 0U, Count);
+}
+
+/**
+ * @brief  This function uses to get the display RAM as shown: blink phase and cursor applied
+ *
+ * @param[out]  pRam  : LCD_SEGMENT_RAM_SIZE bytes
+ *
+ * @retval     void
+ */
+static void Lcd_Segment_Shown_Ram(uint8_t* pRam)
+{
+    uint8_t row;
+    uint8_t i;
+    uint8_t* pLine;
+
+    memcpy(pRam, LcdDisplayRam, LCD_SEGMENT_RAM_SIZE);
+    if(LcdBlinkOff != 0U)
+    {
+        pRam[0U] &= (uint8_t)~LcdBlinkIndicators;
+    }
+    for(row = 0U; row < LCD_SEGMENT_LINES; row++)
+    {
+        pLine = &pRam[LCD_LINE_RAM_START(row)];
+        for(i = 0U; i < LCD_LINE_RAM_BYTES; i++)
+        {
+            if(LcdCursorCol[row] != 0U)
+            {
+                pLine[i] = (pLine[i] & (uint8_t)~LcdDotMask[row][i]) | LcdCursorMask[row][i];
+            }
+            if(LcdBlinkOff != 0U)
+            {
+                pLine[i] &= (uint8_t)~LcdBlinkMask[row][i];
+            }
+        }
+    }
+}
+
+/**
+ * @brief  This function uses to split the shown display RAM into the four SPI frames of each driver
+ *
+ * @param[in]  None
+ *
+ * @retval     uint32_t : LCD_FRAME_BIT(d, n) set when LcdSpiFrames[d][n] changed
+ */
+static uint32_t Lcd_Segment_Build_Frames(void)
+{
+    uint8_t Shown[LCD_SEGMENT_RAM_SIZE];
+    uint8_t Frames[LCD_FRAME_COUNT][LCD_FRAME_LENGTH];
+    uint8_t* Ram;
+    uint32_t Changed = 0U;
+    uint8_t Driver;
+    uint8_t i;
+
+    Lcd_Segment_Shown_Ram(Shown);
+    /* The DMA may still be reading the cache */
+    Lcd_Segment_Wait();
+
+    for(Driver = 0U; Driver < LCD_SEGMENT_DRIVER_COUNT; Driver++)
+    {
+        Ram = &Shown[LCD_DISPLAY_RAM_SIZE * Driver];
+
+        /*First frame 72 bit Display data 22 bit control data 2 bit direction data*/
+        memcpy(Frames[0],Ram,9U);
+        memcpy(&Frames[0][9],ControlData0,3U);
+        
+        /*Second frame 82 bit Display data 10 bit control data 2 bit direction data*/
+        memcpy(Frames[1],&Ram[9],11U);
+        Frames[1][10] &= (uint8_t)0xF0;
+        memcpy(&Frames[1][11],ControlData1,1U);
+        
+        /*Third frame 60 bit Display data 34 bit control data 2 bit direction data*/
+        for(i=0U; i<8U; i++)
+        {
+            Frames[2][i] = ((Ram[19U+i] & 0x0FU) << 4U)|(Ram[20U+i] >> 4U);
+        }
+        Frames[2][7U] &= (uint8_t)0xF0;
+        memcpy(&Frames[2][8U],ControlData2,4U);
+        
+        /*Final frame 60 bit Display data 34 bit control data 2 bit direction data*/
+        memcpy(Frames[3],&Ram[27],8U);
+        Frames[3][7U] &= (uint8_t)0xF0;
+        memcpy(&Frames[3][8],ControlData3,4U);
+
+        for(i = 0U; i < LCD_FRAME_COUNT; i++)
+        {
+            if(memcmp(LcdSpiFrames[Driver][i], Frames[i], LCD_FRAME_LENGTH) != 0)
+            {
+                memcpy(LcdSpiFrames[Driver][i], Frames[i], LCD_FRAME_LENGTH);
+                Changed |= LCD_FRAME_BIT(Driver, i);
+            }
+        }
+    }
+    return Changed;
+}
+
+/**
+ * @brief  This function uses to send cached SPI frames of all drivers back to back
+ *
+ * @param[in]  Frames  : LCD_FRAME_BIT(d, n) set to send LcdSpiFrames[d][n]
+ *
+ * @retval     void
+ *
+ * @note With LCD_SEGMENT_SPI_HAL 0 the frames are chained on DMA1 channel 2 and the function
+ *       returns at once, the refresh cost grows with the changed frames only
+ */
+static void Lcd_Segment_Send_Frames(uint32_t Frames)
+{
+#if (LCD_SEGMENT_SPI_HAL == 1U)
+    uint8_t i;
+
+    LcdRefreshStart = Timebase_Now();
+    for(i = 0U; i < (LCD_FRAME_COUNT * LCD_SEGMENT_DRIVER_COUNT); i++)
+    {
+        if((Frames & (1UL << i)) != 0U)
+        {
+            Lcd_Frame_Transfer(i / LCD_FRAME_COUNT, LcdSpiFrames[i / LCD_FRAME_COUNT][i % LCD_FRAME_COUNT]);
+        }
+    }
+    LcdRefreshTime = Timebase_Elapsed(LcdRefreshStart);
+#else
+    if(Frames == 0U)
+    {
+        return;
+    }
+    Lcd_Segment_Wait();
+    LcdRefreshStart = Timebase_Now();
+    LcdChainFrames = Frames;
+    LcdChainBusy = 1U;
+    LCD_SPI->CR2 |= SPI_CR2_TXDMAEN;
+    Lcd_Segment_Chain_Next();
+#endif
 }
 
 /*==================================================================================================
@@ -309,76 +752,249 @@ static void Lcd_Frame_Transfer(uint8_t* pLcdSpiFrame)
  */
 void Lcd_Segment_Display_App(void)
 {
-    uint8_t LcdSpiFrame[LCD_FRAME_LENGTH];
-    uint8_t i,TempData;
-    
+    TRACE_ENTER(TRACE_ID_LCD_SEGMENT_DISPLAY_APP);
     //LCD_DISPLAY_ENABLE();
+    Os_Mutex_Lock(&LcdSegmentMutex);
 
-    /* Send the LcdDisplayRam to IC driver */
-    /*First frame 72 bit Display data 22 bit control data 2 bit direction data*/
-    memcpy(LcdSpiFrame,LcdDisplayRam,9U);
-    memcpy(&LcdSpiFrame[9],ControlData0,3U);
-    
-    Lcd_Frame_Transfer(LcdSpiFrame);
-    
-    /*Second frame 82 bit Display data 10 bit control data 2 bit direction data*/
-    memcpy(LcdSpiFrame,&LcdDisplayRam[9],11U);
-    LcdSpiFrame[10] &= (uint8_t)0xF0;
-    memcpy(&LcdSpiFrame[11],ControlData1,1U);
-    
-    Lcd_Frame_Transfer(LcdSpiFrame);
-    
-    /*Third frame 60 bit Display data 34 bit control data 2 bit direction data*/
-    for(i=0U; i<8U; i++)
-    {
-        TempData = ((LcdDisplayRam[19U+i] & 0x0FU) << 4U)|(LcdDisplayRam[20U+i] >> 4U);
-        LcdSpiFrame[i] = TempData;
-    }
-    LcdSpiFrame[7U] &= (uint8_t)0xF0;
-    memcpy(&LcdSpiFrame[8U],ControlData2,4U);
-    
-    Lcd_Frame_Transfer(LcdSpiFrame);
-    
-    /*Final frame 60 bit Display data 34 bit control data 2 bit direction data*/
-    memcpy(LcdSpiFrame,&LcdDisplayRam[27],8U);
-    LcdSpiFrame[7U] &= (uint8_t)0xF0;
-    memcpy(&LcdSpiFrame[8],ControlData3,4U);
-    
-    Lcd_Frame_Transfer(LcdSpiFrame);
+    /* Send the LcdDisplayRam to IC driver, only keep the frames while the driver sleeps */
+    (void)Lcd_Segment_Build_Frames();
+    if(LcdPowerSave == 0U)
+    {
+        Lcd_Segment_Send_Frames(LCD_FRAME_ALL);
+    }
+    Os_Mutex_Unlock(&LcdSegmentMutex);
+    TRACE_EXIT(TRACE_ID_LCD_SEGMENT_DISPLAY_APP);
+}
+
+void Lcd_Segment_Power_Save(void)
+{
+    uint8_t Frame[LCD_FRAME_LENGTH];
+    uint8_t Driver;
+
+    Os_Mutex_Lock(&LcdSegmentMutex);
+    if(LcdPowerSave != 0U)
+    {
+        Os_Mutex_Unlock(&LcdSegmentMutex);
+        return;
+    }
+    LcdPowerSave = 1U;
+    Lcd_Segment_Wait();
+    for(Driver = 0U; Driver < LCD_SEGMENT_DRIVER_COUNT; Driver++)
+    {
+        /* Control data only travels in the DD=00 frame, its display bits are left unchanged */
+        memcpy(Frame, LcdSpiFrames[Driver][0], LCD_FRAME_LENGTH);
+        Frame[LCD_FRAME_LENGTH - 1U] |= LCD_CONTROL_SC | LCD_CONTROL_BU;
+        Lcd_Frame_Transfer(Driver, Frame);
+    }
+    Os_Mutex_Unlock(&LcdSegmentMutex);
+}
+
+void Lcd_Segment_Resume(void)
+{
+    Os_Mutex_Lock(&LcdSegmentMutex);
+    if(LcdPowerSave != 0U)
+    {
+        LcdPowerSave = 0U;
+        /* The cached DD=00 frame carries the normal mode control data, one burst brings the panel back */
+        Lcd_Segment_Send_Frames(LCD_FRAME_ALL);
+    }
+    Os_Mutex_Unlock(&LcdSegmentMutex);
+}
+
+uint8_t Lcd_Segment_Is_Power_Save(void)
+{
+    return LcdPowerSave;
+}
+
+Std_Return_Type Lcd_Segment_Marquee_Start(uint8_t line, const uint8_t* pData, uint16_t len, uint16_t StepMs)
+{
+    Lcd_Segment_Marquee_Type* pMarquee;
+    uint16_t i;
+    uint8_t Digits = 0U;
+
+    if((line >= LCD_SEGMENT_LINES) || (len > LCD_SEGMENT_MARQUEE_SIZE))
+    {
+        return E_NOT_OK;
+    }
+    Os_Mutex_Lock(&LcdSegmentMutex);
+    pMarquee = &LcdMarquee[line];
+    pMarquee->Length = 0U;
+    for(i = 0U; i < len; i++)
+    {
+        if((pData[i] != '.') && (pData[i] != ','))
+        {
+            Digits++;
+        }
+    }
+    if(Digits <= LCD_SEGMENT_COLS)
+    {
+        Lcd_Segment_Put_Data_Ring(line, pData, LCD_SEGMENT_LINEAR_MASK, 0U, len);
+    }
+    else
+    {
+        memcpy(pMarquee->Text, pData, len);
+        pMarquee->Start = 0U;
+        pMarquee->Step = (uint32_t)((StepMs != 0U) ? StepMs : LCD_SEGMENT_MARQUEE_DEFAULT_STEP_MS) * 1000U;
+        pMarquee->Deadline = Timebase_Deadline_After(pMarquee->Step);
+        pMarquee->Length = (uint8_t)len;
+        Lcd_Segment_Marquee_Show(line);
+    }
+    Os_Mutex_Unlock(&LcdSegmentMutex);
+    return E_OK;
+}
+
+void Lcd_Segment_Marquee_Stop(uint8_t line)
+{
+    if(line < LCD_SEGMENT_LINES)
+    {
+        Os_Mutex_Lock(&LcdSegmentMutex);
+        LcdMarquee[line].Length = 0U;
+        Os_Mutex_Unlock(&LcdSegmentMutex);
+    }
+}
+
+void Lcd_Segment_Marquee_Task(void)
+{
+    Lcd_Segment_Marquee_Type* pMarquee;
+    uint8_t line;
+    uint8_t Stepped = 0U;
+
+    Os_Mutex_Lock(&LcdSegmentMutex);
+    for(line = 0U; line < LCD_SEGMENT_LINES; line++)
+    {
+        pMarquee = &LcdMarquee[line];
+        if((pMarquee->Length == 0U) || (Timebase_Expired(pMarquee->Deadline) == 0U))
+        {
+            continue;
+        }
+        pMarquee->Deadline = Timebase_Deadline_After(pMarquee->Step);
+        /* Next digit, a dot or comma has no column of its own */
+        do
+        {
+            pMarquee->Start = (pMarquee->Start + 1U < pMarquee->Length + LCD_SEGMENT_COLS) ? (pMarquee->Start + 1U) : 0U;
+        }while((pMarquee->Start < pMarquee->Length)
+               && ((pMarquee->Text[pMarquee->Start] == '.') || (pMarquee->Text[pMarquee->Start] == ',')));
+        Lcd_Segment_Marquee_Show(line);
+        Stepped = 1U;
+    }
+    if(Stepped != 0U)
+    {
+        Lcd_Segment_Flush();
+    }
+    Os_Mutex_Unlock(&LcdSegmentMutex);
+}
+
+uint32_t Lcd_Segment_Get_Refresh_Time(void)
+{
+    return LcdRefreshTime;
+}
+
+uint8_t Lcd_Segment_Is_Busy(void)
+{
+#if (LCD_SEGMENT_SPI_HAL == 0U)
+    return LcdChainBusy;
+#else
+    return 0U;
+#endif
+}
+
+void Lcd_Segment_Wait_Idle(void)
+{
+    /* One waiter on LcdChainDone at a time */
+    Os_Mutex_Lock(&LcdSegmentMutex);
+    Lcd_Segment_Wait();
+    Os_Mutex_Unlock(&LcdSegmentMutex);
 }
 
 
 void Lcd_Segment_Init(void)
 {
+#if (PECO10_LL_BUILD == 0U)
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+#endif
+    uint8_t Driver;
+
+    Os_Mutex_Init(&LcdSegmentMutex);
+    /* SCE of every driver low, driver 0 is already set up by MX_GPIO_Init */
+    for(Driver = 0U; Driver < LCD_SEGMENT_DRIVER_COUNT; Driver++)
+    {
+        LCD_CS_DISABLE(Driver);
+#if (PECO10_LL_BUILD == 1U)
+        Ll_Init_Gpio(LcdSegmentDrivers[Driver].CsPort, LcdSegmentDrivers[Driver].CsPin, LL_INIT_GPIO_MODE_OUTPUT,
+                     LL_INIT_GPIO_PULL_NO, 0U);
+#else
+        GPIO_InitStruct.Pin = LcdSegmentDrivers[Driver].CsPin;
+        GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+        GPIO_InitStruct.Pull = GPIO_NOPULL;
+        GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+        HAL_GPIO_Init(LcdSegmentDrivers[Driver].CsPort, &GPIO_InitStruct);
+#endif
+    }
+
+#if (LCD_SEGMENT_SPI_HAL == 0U)
+    Os_Semaphore_Init(&LcdChainDone);
+    __HAL_RCC_DMA1_CLK_ENABLE();
+    /* DMA1 channel 2: one frame -> SPI1 DR per transfer, restarted by the interrupt for the next frame */
+    LL_DMA_SetPeriphRequest(LCD_DMA, LCD_DMA_CHANNEL, LL_DMAMUX_REQ_SPI1_TX);
+    LL_DMA_ConfigTransfer(LCD_DMA, LCD_DMA_CHANNEL, LL_DMA_DIRECTION_MEMORY_TO_PERIPH |
+                          LL_DMA_MODE_NORMAL | LL_DMA_PERIPH_NOINCREMENT | LL_DMA_MEMORY_INCREMENT |
+                          LL_DMA_PDATAALIGN_BYTE | LL_DMA_MDATAALIGN_BYTE | LL_DMA_PRIORITY_LOW);
+    LL_DMA_SetPeriphAddress(LCD_DMA, LCD_DMA_CHANNEL, (uint32_t)&LCD_SPI->DR);
+    LL_DMA_EnableIT_TC(LCD_DMA, LCD_DMA_CHANNEL);
+    NVIC_SetPriority(DMA1_Channel2_3_IRQn, 2U);
+    NVIC_EnableIRQ(DMA1_Channel2_3_IRQn);
+#endif
+
     /* Clear LCD Display RAM, except first byte - indicator display byte */
-    memset(&LcdDisplayRam[1U], 0U, LCD_DISPLAY_RAM_SIZE - 1U);
+    memset(&LcdDisplayRam[1U], 0U, LCD_SEGMENT_RAM_SIZE - 1U);
+    (void)Lcd_Segment_Build_Frames();
 }
 
 /**
  * @brief  This function uses to prepare data which will be displayed to LCD segment
  *
  * @param[in]  pData  : data to be displayed
- *             line   : LCD line index [0-2]
+ *             line   : LCD line index [0-LCD_SEGMENT_LINES-1]
  *
  * @retval void
  *
  * @implement Lcd_Segment_Put_Data_Activity
  */
 void Lcd_Segment_Put_Data(uint8_t* pData, uint8_t line)
+{
+    Lcd_Segment_Put_Data_Ring(line, pData, LCD_SEGMENT_LINEAR_MASK, 0U, strlen((char*)pData));
+}
+
+/**
+ * @brief  This function uses to prepare data of one line read in place from a ring buffer
+ *
+ * @param[in]  line    : LCD line index [0-LCD_SEGMENT_LINES-1]
+ *             pRing   : ring buffer base
+ *             Mask    : ring size - 1 (power of 2), LCD_SEGMENT_LINEAR_MASK for a plain array
+ *             Start   : index of the first character
+ *             len     : number of characters
+ *
+ * @retval void
+ *
+ * @implement Lcd_Segment_Put_Data_Ring_Activity
+ */
+void Lcd_Segment_Put_Data_Ring(uint8_t line, const uint8_t* pRing, uint16_t Mask, uint16_t Start, uint16_t len)
 {
     uint8_t i=0;
-    uint8_t j=0;
-    uint8_t len = strlen((char*)pData);
-    if(line <= 2)
+    uint16_t j=0;
+    uint8_t Data;
+    if(line < LCD_SEGMENT_LINES)
     {
+        Os_Mutex_Lock(&LcdSegmentMutex);
         /*clear line Lcd ram buffer data*/
-        memset(&LcdDisplayRam[19 - 9 * line], 0U, 9);
+        memset(&LcdDisplayRam[LCD_LINE_RAM_START(line)], 0U, LCD_LINE_RAM_BYTES);
         while(i<7)
         {
             if((i + j) < len)
             {
-                Lcd_Segment_Prepare_Display_Ram((LCD_SEGMENT_COLS - i) ,line, pData[len-1-i-j]);
-                if((pData[len - 1 - i - j] == '.')||(pData[len - 1 - i - j] == ','))
+                Data = pRing[(uint16_t)(Start + len - 1U - i - j) & Mask];
+                Lcd_Segment_Prepare_Display_Ram((LCD_SEGMENT_COLS - i) ,line, Data);
+                if((Data == '.')||(Data == ','))
                 {
                     j++;
                 }else{
@@ -389,18 +1005,248 @@ void Lcd_Segment_Put_Data(uint8_t* pData, uint8_t line)
                 i++;
             }
         }
+        Os_Mutex_Unlock(&LcdSegmentMutex);
+    }
+}
+
+Std_Return_Type Lcd_Segment_Put_Char(uint8_t line, uint8_t col, uint8_t Data)
+{
+    if((line >= LCD_SEGMENT_LINES) || (col == 0U) || (col > LCD_SEGMENT_COLS))
+    {
+        return E_NOT_OK;
     }
+    Os_Mutex_Lock(&LcdSegmentMutex);
+    Lcd_Segment_Prepare_Display_Ram(col, line, Data);
+    Os_Mutex_Unlock(&LcdSegmentMutex);
+    return E_OK;
+}
+
+void Lcd_Segment_Flush(void)
+{
+    uint32_t Frames;
+
+    Os_Mutex_Lock(&LcdSegmentMutex);
+    Frames = Lcd_Segment_Build_Frames();
+    if(LcdPowerSave == 0U)
+    {
+        Lcd_Segment_Send_Frames(Frames);
+    }
+    Os_Mutex_Unlock(&LcdSegmentMutex);
 }
 
 void Lcd_Segment_Put_Indicator(uint8_t Data)
 {
-    /* Copy indicator byte to display RAM */
-    LcdDisplayRam[0U] = Data & 0xF8U;
-    return; 
+    Os_Mutex_Lock(&LcdSegmentMutex);
+    /* Copy indicator byte to display RAM, the next flush finds frame 0 changed */
+    LcdDisplayRam[0U] = Data & LCD_INDICATOR_ALL;
+    Os_Mutex_Unlock(&LcdSegmentMutex);
+}
+
+void Lcd_Segment_Set_Indicator(uint8_t Indicators, uint8_t State)
+{
+    Indicators &= LCD_INDICATOR_ALL;
+    Os_Mutex_Lock(&LcdSegmentMutex);
+    if(State != 0U)
+    {
+        LcdDisplayRam[0U] |= Indicators;
+    }else
+    {
+        LcdDisplayRam[0U] &= (uint8_t)~Indicators;
+    }
+    Os_Mutex_Unlock(&LcdSegmentMutex);
+}
+
+void Lcd_Segment_Blink_Indicator(uint8_t Indicators)
+{
+    Os_Mutex_Lock(&LcdSegmentMutex);
+    Lcd_Segment_Blink_Start();
+    LcdBlinkIndicators = Indicators & LCD_INDICATOR_ALL;
+    Os_Mutex_Unlock(&LcdSegmentMutex);
+}
+
+Std_Return_Type Lcd_Segment_Blink_Digits(uint8_t line, uint8_t Cols)
+{
+    uint8_t col;
+
+    if(line >= LCD_SEGMENT_LINES)
+    {
+        return E_NOT_OK;
+    }
+    Os_Mutex_Lock(&LcdSegmentMutex);
+    Lcd_Segment_Blink_Start();
+    LcdBlinkDigits[line] = Cols & (uint8_t)((1U << LCD_SEGMENT_COLS) - 1U);
+    memset(LcdBlinkMask[line], 0U, LCD_LINE_RAM_BYTES);
+    for(col = 1U; col <= LCD_SEGMENT_COLS; col++)
+    {
+        if((LcdBlinkDigits[line] & LCD_SEGMENT_DIGIT(col)) != 0U)
+        {
+            Lcd_Segment_Cell_Mask(col, line, '8', LcdBlinkMask[line]);
+        }
+    }
+    Os_Mutex_Unlock(&LcdSegmentMutex);
+    return E_OK;
+}
+
+Std_Return_Type Lcd_Segment_Set_Cursor(uint8_t line, uint8_t col)
+{
+    uint8_t i;
+
+    if((line >= LCD_SEGMENT_LINES) || (col > LCD_SEGMENT_COLS))
+    {
+        return E_NOT_OK;
+    }
+    Os_Mutex_Lock(&LcdSegmentMutex);
+    LcdCursorCol[line] = col;
+    memset(LcdCursorMask[line], 0U, LCD_LINE_RAM_BYTES);
+    memset(LcdDotMask[line], 0U, LCD_LINE_RAM_BYTES);
+    if(col != 0U)
+    {
+        Lcd_Segment_Cell_Mask(col, line, '.', LcdCursorMask[line]);
+        for(i = 1U; i <= LCD_SEGMENT_COLS; i++)
+        {
+            Lcd_Segment_Cell_Mask(i, line, ',', LcdDotMask[line]);
+        }
+    }
+    Os_Mutex_Unlock(&LcdSegmentMutex);
+    return E_OK;
+}
+
+void Lcd_Segment_Set_Blink_Rate(uint16_t HalfPeriodMs)
+{
+    if(HalfPeriodMs == 0U)
+    {
+        HalfPeriodMs = 1U;
+    }
+    Os_Mutex_Lock(&LcdSegmentMutex);
+    LcdBlinkPeriod = (uint32_t)HalfPeriodMs * 1000U;
+    Os_Mutex_Unlock(&LcdSegmentMutex);
+}
+
+void Lcd_Segment_Blink_Task(void)
+{
+    uint8_t Toggled = 1U;
+
+    Os_Mutex_Lock(&LcdSegmentMutex);
+    if(Lcd_Segment_Is_Blinking() == 0U)
+    {
+        /* Blinking stopped in the off phase, show everything again */
+        Toggled = LcdBlinkOff;
+        LcdBlinkOff = 0U;
+    }
+    else if(Timebase_Expired(LcdBlinkDeadline) == 0U)
+    {
+        Toggled = 0U;
+    }
+    else
+    {
+        LcdBlinkDeadline = Timebase_Deadline_After(LcdBlinkPeriod);
+        LcdBlinkOff ^= 1U;
+    }
+    if(Toggled != 0U)
+    {
+        /* Only the frames holding a toggled bit differ from the cache */
+        Lcd_Segment_Flush();
+    }
+    Os_Mutex_Unlock(&LcdSegmentMutex);
+}
+
+/**
+ * @brief  This function uses to display a signed number right aligned on one line
+ *
+ * @param[in]  line          : LCD line index [0-LCD_SEGMENT_LINES-1]
+ *             Value         : number to display
+ *             DecimalPlace  : digits after the separator [0-6]
+ *             Separator     : '.' or ','
+ *
+ * @retval Std_Return_Type
+ *
+ * @implement Lcd_Segment_Put_Number_Activity
+ */
+Std_Return_Type Lcd_Segment_Put_Number(uint8_t line, int32_t Value, uint8_t DecimalPlace, uint8_t Separator)
+{
+    uint32_t Magnitude;
+    uint8_t col = LCD_SEGMENT_COLS;
+    uint8_t Minimum;
+    Std_Return_Type Status = E_OK;
+
+    if((line >= LCD_SEGMENT_LINES) || (DecimalPlace >= LCD_SEGMENT_COLS))
+    {
+        return E_NOT_OK;
+    }
+    Magnitude = (Value < 0) ? (0U - (uint32_t)Value) : (uint32_t)Value;
+    /* Digits to draw even if zero: the fraction and the units */
+    Minimum = DecimalPlace + 1U;
+
+    Os_Mutex_Lock(&LcdSegmentMutex);
+    memset(&LcdDisplayRam[LCD_LINE_RAM_START(line)], 0U, LCD_LINE_RAM_BYTES);
+    while(col > 0U)
+    {
+        if((Magnitude != 0U) || ((LCD_SEGMENT_COLS - col) < Minimum))
+        {
+            Lcd_Segment_Prepare_Display_Ram(col, line, (uint8_t)('0' + (Magnitude % 10U)));
+            Magnitude /= 10U;
+        }
+        else if(Value < 0)
+        {
+            Lcd_Segment_Prepare_Display_Ram(col, line, '-');
+            Value = 0;
+        }
+        else
+        {
+            Lcd_Segment_Prepare_Display_Ram(col, line, ' ');
+        }
+        col--;
+    }
+    if((Magnitude != 0U) || (Value < 0))
+    {
+        /* Does not fit in 7 digits */
+        for(col = 1U; col <= LCD_SEGMENT_COLS; col++)
+        {
+            Lcd_Segment_Prepare_Display_Ram(col, line, '-');
+        }
+        Status = E_NOT_OK;
+    }
+    else if(DecimalPlace != 0U)
+    {
+        /* The dot at col c follows digit c */
+        Lcd_Segment_Prepare_Display_Ram(LCD_SEGMENT_COLS - DecimalPlace, line, (Separator == ',') ? ',' : '.');
+    }
+    Os_Mutex_Unlock(&LcdSegmentMutex);
+    return Status;
+}
+
+/**
+ * @brief  This function uses to write raw bytes into the LCD display RAM
+ *
+ * @param[in]  Offset  : first LcdDisplayRam byte, all drivers
+ *             pRing   : ring buffer base
+ *             Mask    : ring size - 1 (power of 2), LCD_SEGMENT_LINEAR_MASK for a plain array
+ *             Start   : index of the first byte
+ *             len     : number of bytes
+ *
+ * @retval Std_Return_Type
+ *
+ * @implement Lcd_Segment_Put_Ram_Activity
+ */
+Std_Return_Type Lcd_Segment_Put_Ram(uint8_t Offset, const uint8_t* pRing, uint16_t Mask, uint16_t Start, uint16_t len)
+{
+    uint16_t i;
+    if(((uint16_t)Offset + len) > LCD_SEGMENT_RAM_SIZE)
+    {
+        return E_NOT_OK;
+    }
+    Os_Mutex_Lock(&LcdSegmentMutex);
+    for(i = 0U; i < len; i++)
+    {
+        LcdDisplayRam[Offset + i] = pRing[(uint16_t)(Start + i) & Mask];
+    }
+    Os_Mutex_Unlock(&LcdSegmentMutex);
+    return E_OK;
 }
 /*==================================================================================================
 *                                        INTERUPT HANDLER FUNCTIONS
 ==================================================================================================*/
+#if (LCD_SEGMENT_SPI_HAL == 1U)
 /**
  * @brief  This function is SPI Tx complete callback
  */
@@ -408,6 +1254,21 @@ void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
 {   
     if(hspi == &hspi1)
     {
-        LCD_CS_DISABLE();
+        LCD_CS_DISABLE(LcdCsDriver);
+        TRACE_INSTANT(TRACE_ID_LCD_SCE, 0U);
+    }
+}
+#else
+void Lcd_Segment_Dma_IRQHandler(void)
+{
+    if(LL_DMA_IsActiveFlag_TC2(LCD_DMA) != 0U)
+    {
+        LL_DMA_ClearFlag_TC2(LCD_DMA);
+        /* TC fires once the last byte is in the FIFO, wait until it has been shifted out (4 bytes at most) */
+        while(((LCD_SPI->SR & SPI_SR_FTLVL) != 0U) || ((LCD_SPI->SR & SPI_SR_BSY) != 0U));
+        LCD_CS_DISABLE(LcdChainFrame / LCD_FRAME_COUNT);
+        TRACE_INSTANT(TRACE_ID_LCD_SCE, 0U);
+        Lcd_Segment_Chain_Next();
     }
 }
+#endif
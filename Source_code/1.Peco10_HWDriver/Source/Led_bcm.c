@@ -0,0 +1,246 @@
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+#include "Led_bcm.h"
+/*==================================================================================================
+                                           CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+/* Ticks plane n is shown */
+#define LED_BCM_PLANE_TICKS(__N__)              (LedBcmBaseUs << (__N__))
+/*==================================================================================================
+*                                              ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  LOCAL VARIABLE DECLARATIONS
+==================================================================================================*/
+/* Brightness of each chain output */
+static uint8_t LedBcmLevel[IC_74HC595_OUTPUTS];
+/* Outputs driven by the engine, per stage */
+static uint8_t LedBcmMask[IC_74HC595_STAGES];
+/* Chain image of each bit plane, only the LedBcmMask bits are used */
+static uint8_t LedBcmPlane[LED_BCM_BITS][IC_74HC595_STAGES];
+/* Plane on the outputs */
+static uint8_t LedBcmPlaneIndex = 0U;
+/* Plane 0 time in us, measured by Led_Bcm_Calibrate */
+static uint32_t LedBcmBaseUs = 0U;
+/* Set between Led_Bcm_Suspend and Led_Bcm_Resume */
+static uint8_t LedBcmSuspended = 0U;
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+static uint8_t Led_Bcm_Is_Used(void);
+static void Led_Bcm_Calibrate(void);
+static void Led_Bcm_Start(void);
+
+/*==================================================================================================
+*                                         LOCAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief  This function uses to know whether an output is driven by the engine
+ */
+static uint8_t Led_Bcm_Is_Used(void)
+{
+    uint8_t Stage;
+
+    for(Stage = 0U; Stage < IC_74HC595_STAGES; Stage++)
+    {
+        if(LedBcmMask[Stage] != 0U)
+        {
+            return 1U;
+        }
+    }
+    return 0U;
+}
+
+/**
+ * @brief  This function uses to derive the base period from the time of one chain update
+ */
+static void Led_Bcm_Calibrate(void)
+{
+    static const uint8_t None[IC_74HC595_STAGES] = {0U};
+    uint32_t Start;
+    uint32_t Elapsed;
+    uint32_t Fastest = 0xFFFFFFFFU;
+    uint8_t Run;
+
+    for(Run = 0U; Run < LED_BCM_CALIBRATION_RUNS; Run++)
+    {
+        /* Nothing changes, the chain is still shifted out and latched like in the interrupt */
+        Start = Timebase_Now();
+        (void)IC_74hc595_Write_Chain(None, None);
+        Elapsed = Timebase_Elapsed(Start);
+        if(Elapsed < Fastest)
+        {
+            Fastest = Elapsed;
+        }
+    }
+    if(Timebase_Get_Clock_Mode() == TIMEBASE_CLOCK_FAST)
+    {
+        /* The interrupt may come while the main loop idles at 16 MHz */
+        Fastest *= TIMEBASE_FAST_CLOCK_HZ / HSI_VALUE;
+    }
+    LedBcmBaseUs = Fastest * LED_BCM_BASE_FACTOR;
+    if(LedBcmBaseUs < LED_BCM_BASE_MIN_US)
+    {
+        LedBcmBaseUs = LED_BCM_BASE_MIN_US;
+    }
+}
+
+/**
+ * @brief  This function uses to start the bit planes, interrupts masked by the caller
+ */
+static void Led_Bcm_Start(void)
+{
+    /* First plane one base period from now, the interrupt moves on to plane 0 */
+    LedBcmPlaneIndex = LED_BCM_BITS - 1U;
+    LED_BCM_TIM->CCR2 = LED_BCM_TIM->CNT + LedBcmBaseUs;
+    LED_BCM_TIM->SR = ~TIM_SR_CC2IF;
+    LED_BCM_TIM->DIER |= TIM_DIER_CC2IE;
+}
+
+/*==================================================================================================
+*                                         GLOBAL FUNCTIONS
+==================================================================================================*/
+Std_Return_Type Led_Bcm_Set_Level(uint16_t Output, uint8_t Level)
+{
+    uint8_t Stage = (uint8_t)(Output >> 3U);
+    uint8_t Bit = (uint8_t)(1U << (Output & 0x07U));
+    uint8_t Plane;
+    uint32_t Primask;
+
+    if(Output >= IC_74HC595_OUTPUTS)
+    {
+        return E_NOT_OK;
+    }
+    if(LedBcmBaseUs == 0U)
+    {
+        Led_Bcm_Calibrate();
+    }
+    Primask = __get_PRIMASK();
+    __disable_irq();
+    LedBcmLevel[Output] = Level;
+    for(Plane = 0U; Plane < LED_BCM_BITS; Plane++)
+    {
+        if((Level & (1U << Plane)) != 0U)
+        {
+            LedBcmPlane[Plane][Stage] |= Bit;
+        }
+        else
+        {
+            LedBcmPlane[Plane][Stage] &= (uint8_t)~Bit;
+        }
+    }
+    if((LedBcmSuspended == 0U) && ((LED_BCM_TIM->DIER & TIM_DIER_CC2IE) == 0U))
+    {
+        Led_Bcm_Start();
+    }
+    LedBcmMask[Stage] |= Bit;
+    __set_PRIMASK(Primask);
+    return E_OK;
+}
+
+uint8_t Led_Bcm_Get_Level(uint16_t Output)
+{
+    if((Output >= IC_74HC595_OUTPUTS) || ((LedBcmMask[Output >> 3U] & (1U << (Output & 0x07U))) == 0U))
+    {
+        return 0U;
+    }
+    return LedBcmLevel[Output];
+}
+
+void Led_Bcm_Release(uint16_t Output)
+{
+    uint32_t Primask;
+
+    if(Output >= IC_74HC595_OUTPUTS)
+    {
+        return;
+    }
+    Primask = __get_PRIMASK();
+    __disable_irq();
+    LedBcmMask[Output >> 3U] &= (uint8_t)~(1U << (Output & 0x07U));
+    LedBcmLevel[Output] = 0U;
+    if(Led_Bcm_Is_Used() == 0U)
+    {
+        LED_BCM_TIM->DIER &= ~TIM_DIER_CC2IE;
+        LED_BCM_TIM->SR = ~TIM_SR_CC2IF;
+    }
+    __set_PRIMASK(Primask);
+    (void)IC_74hc595_Clear_Bit(Output);
+}
+
+uint32_t Led_Bcm_Get_Base_Us(void)
+{
+    return LedBcmBaseUs;
+}
+
+void Led_Bcm_Suspend(void)
+{
+    uint32_t Primask;
+
+    Primask = __get_PRIMASK();
+    __disable_irq();
+    LedBcmSuspended = 1U;
+    LED_BCM_TIM->DIER &= ~TIM_DIER_CC2IE;
+    LED_BCM_TIM->SR = ~TIM_SR_CC2IF;
+    __set_PRIMASK(Primask);
+    if(Led_Bcm_Is_Used() != 0U)
+    {
+        (void)IC_74hc595_Write_Chain(LedBcmMask, LedBcmPlane[LED_BCM_STATIC_PLANE]);
+    }
+}
+
+void Led_Bcm_Resume(void)
+{
+    uint32_t Primask;
+
+    Primask = __get_PRIMASK();
+    __disable_irq();
+    LedBcmSuspended = 0U;
+    if(Led_Bcm_Is_Used() != 0U)
+    {
+        Led_Bcm_Start();
+    }
+    __set_PRIMASK(Primask);
+}
+
+/*==================================================================================================
+*                                        INTERUPT HANDLER FUNCTIONS
+==================================================================================================*/
+void Led_Bcm_Timer_IRQHandler(void)
+{
+    uint32_t Next;
+
+    if(((LED_BCM_TIM->DIER & TIM_DIER_CC2IE) == 0U) || ((LED_BCM_TIM->SR & TIM_SR_CC2IF) == 0U))
+    {
+        return;
+    }
+    LED_BCM_TIM->SR = ~TIM_SR_CC2IF;
+    LedBcmPlaneIndex = (LedBcmPlaneIndex + 1U) % LED_BCM_BITS;
+    /* Advance from the previous compare so the cycle does not drift with the interrupt latency,
+     * restart from now if the latency ate the whole plane (the compare would wait a full wrap) */
+    Next = LED_BCM_TIM->CCR2 + LED_BCM_PLANE_TICKS(LedBcmPlaneIndex);
+    if((int32_t)(Next - LED_BCM_TIM->CNT) < 2)
+    {
+        Next = LED_BCM_TIM->CNT + LED_BCM_PLANE_TICKS(LedBcmPlaneIndex);
+    }
+    LED_BCM_TIM->CCR2 = Next;
+    /* A shift preempted in the main loop latches the plane when this returns */
+    (void)IC_74hc595_Write_Chain(LedBcmMask, LedBcmPlane[LedBcmPlaneIndex]);
+}
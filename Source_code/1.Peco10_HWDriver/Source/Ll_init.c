@@ -0,0 +1,184 @@
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+#include "Ll_init.h"
+#include "Timebase.h"
+#include "stm32g0xx_ll_rcc.h"
+
+#if (PECO10_LL_BUILD == 1U)
+/*==================================================================================================
+                                           CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+#define LL_INIT_TIM1_PERIOD                     (999U)
+
+/*==================================================================================================
+*                                              ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  LOCAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+static void Ll_Init_Clock(void);
+static void Ll_Init_Pins(void);
+static void Ll_Init_Tim1(void);
+static void Ll_Init_Tim2(void);
+static void Ll_Init_Spi1(void);
+
+/*==================================================================================================
+*                                         LOCAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief  This function uses to run from HSI16 with no wait state, as SystemClock_Config
+ */
+static void Ll_Init_Clock(void)
+{
+    /* Prefetch and instruction cache, as HAL_Init */
+    FLASH->ACR |= FLASH_ACR_PRFTEN | FLASH_ACR_ICEN;
+    RCC->APBENR2 |= RCC_APBENR2_SYSCFGEN;
+    RCC->APBENR1 |= RCC_APBENR1_PWREN;
+
+    /* HSI16 undivided, voltage range 1 is the reset state */
+    LL_RCC_HSI_Enable();
+    while(LL_RCC_HSI_IsReady() == 0U);
+    LL_RCC_SetHSIDiv(LL_RCC_HSI_DIV_1);
+    LL_RCC_SetAHBPrescaler(LL_RCC_SYSCLK_DIV_1);
+    LL_RCC_SetAPB1Prescaler(LL_RCC_APB1_DIV_1);
+    LL_RCC_SetSysClkSource(LL_RCC_SYS_CLKSOURCE_HSI);
+    while(LL_RCC_GetSysClkSource() != LL_RCC_SYS_CLKSOURCE_STATUS_HSI);
+    FLASH->ACR &= ~FLASH_ACR_LATENCY;
+    SystemCoreClock = HSI_VALUE;
+}
+
+/**
+ * @brief  This function uses to configure the pins of MX_GPIO_Init and the MSP post init
+ */
+static void Ll_Init_Pins(void)
+{
+    RCC->IOPENR |= RCC_IOPENR_GPIOAEN | RCC_IOPENR_GPIOBEN | RCC_IOPENR_GPIOCEN | RCC_IOPENR_GPIOFEN;
+
+    /* Output levels first so the pins come up low */
+    GPIOB->BRR = GPIO_PIN_7 | GPIO_PIN_3;
+    GPIOC->BRR = GPIO_PIN_14 | GPIO_PIN_15;
+    GPIOF->BRR = GPIO_PIN_2;
+    GPIOA->BRR = GPIO_PIN_4 | GPIO_PIN_5 | GPIO_PIN_6 | GPIO_PIN_11;
+
+    /* 595 shift clock, mux A / 595 latch, data, mux B and C / LCD SCE / spare outputs */
+    Ll_Init_Gpio(GPIOB, GPIO_PIN_7 | GPIO_PIN_3, LL_INIT_GPIO_MODE_OUTPUT, LL_INIT_GPIO_PULL_NO, 0U);
+    Ll_Init_Gpio(GPIOC, GPIO_PIN_14 | GPIO_PIN_15, LL_INIT_GPIO_MODE_OUTPUT, LL_INIT_GPIO_PULL_NO, 0U);
+    Ll_Init_Gpio(GPIOF, GPIO_PIN_2, LL_INIT_GPIO_MODE_OUTPUT, LL_INIT_GPIO_PULL_NO, 0U);
+    Ll_Init_Gpio(GPIOA, GPIO_PIN_4 | GPIO_PIN_5 | GPIO_PIN_6 | GPIO_PIN_11, LL_INIT_GPIO_MODE_OUTPUT,
+                 LL_INIT_GPIO_PULL_NO, 0U);
+    /* 74LS151 Y */
+    Ll_Init_Gpio(GPIOA, GPIO_PIN_12, LL_INIT_GPIO_MODE_INPUT, LL_INIT_GPIO_PULL_NO, 0U);
+    /* SPI1 SCK / MOSI */
+    Ll_Init_Gpio(GPIOA, GPIO_PIN_1 | GPIO_PIN_7, LL_INIT_GPIO_MODE_ALTERNATE, LL_INIT_GPIO_PULL_NO, GPIO_AF0_SPI1);
+    /* TIM1 CH1 backlight */
+    Ll_Init_Gpio(GPIOA, GPIO_PIN_8, LL_INIT_GPIO_MODE_ALTERNATE, LL_INIT_GPIO_PULL_NO, GPIO_AF2_TIM1);
+}
+
+/**
+ * @brief  This function uses to configure TIM1 CH1 PWM mode 1, 1 kHz, preloaded CCR1, as MX_TIM1_Init
+ *
+ * @note The counter and output are started by Backlight_Init
+ */
+static void Ll_Init_Tim1(void)
+{
+    RCC->APBENR2 |= RCC_APBENR2_TIM1EN;
+    TIM1->PSC = TIMEBASE_PRESCALER(SystemCoreClock);
+    TIM1->ARR = LL_INIT_TIM1_PERIOD;
+    TIM1->CCMR1 = TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1 | TIM_CCMR1_OC1PE;
+    TIM1->CCR1 = 0U;
+    TIM1->EGR = TIM_EGR_UG;
+    TIM1->SR = 0U;
+
+    NVIC_SetPriority(TIM1_BRK_UP_TRG_COM_IRQn, 2U);
+    NVIC_EnableIRQ(TIM1_BRK_UP_TRG_COM_IRQn);
+}
+
+/**
+ * @brief  This function uses to configure TIM2 as a free running 32 bit 1 MHz counter, as MX_TIM2_Init
+ *
+ * @note The counter is started by Timebase_Init
+ */
+static void Ll_Init_Tim2(void)
+{
+    RCC->APBENR1 |= RCC_APBENR1_TIM2EN;
+    TIM2->PSC = TIMEBASE_PRESCALER(SystemCoreClock);
+    TIM2->ARR = 0xFFFFFFFFU;
+    TIM2->EGR = TIM_EGR_UG;
+    TIM2->SR = 0U;
+
+    NVIC_SetPriority(TIM2_IRQn, 1U);
+    NVIC_EnableIRQ(TIM2_IRQn);
+}
+
+/**
+ * @brief  This function uses to configure SPI1 master, 8 bit, mode 0, MSB first, software NSS
+ *
+ * @note BR is set by Timebase_Update_Prescalers, SPE by the segment LCD driver
+ */
+static void Ll_Init_Spi1(void)
+{
+    RCC->APBENR2 |= RCC_APBENR2_SPI1EN;
+    SPI1->CR1 = SPI_CR1_MSTR | SPI_CR1_SSM | SPI_CR1_SSI;
+    /* 8 bit frames, RXNE at a quarter FIFO, NSS pulse as in MX_SPI1_Init */
+    SPI1->CR2 = (7U << SPI_CR2_DS_Pos) | SPI_CR2_FRXTH | SPI_CR2_NSSP;
+}
+
+/*==================================================================================================
+*                                        GLOBAL FUNCTIONS
+==================================================================================================*/
+void Ll_Init_System(void)
+{
+    Ll_Init_Clock();
+    Ll_Init_Pins();
+    Ll_Init_Spi1();
+    Ll_Init_Tim1();
+    Ll_Init_Tim2();
+    Timebase_Update_Prescalers();
+}
+
+void Ll_Init_Gpio(GPIO_TypeDef* Port, uint32_t Pins, uint32_t Mode, uint32_t Pull, uint32_t Alternate)
+{
+    uint32_t Pin;
+    uint32_t Primask = __get_PRIMASK();
+
+    __disable_irq();
+    for(Pin = 0U; Pin < 16U; Pin++)
+    {
+        if((Pins & (1UL << Pin)) == 0U)
+        {
+            continue;
+        }
+        if(Mode == LL_INIT_GPIO_MODE_ALTERNATE)
+        {
+            Port->AFR[Pin >> 3U] = (Port->AFR[Pin >> 3U] & ~(0xFUL << ((Pin & 7U) << 2U)))
+                                 | (Alternate << ((Pin & 7U) << 2U));
+        }
+        Port->OTYPER &= ~(1UL << Pin);
+        Port->OSPEEDR &= ~(3UL << (Pin << 1U));
+        Port->PUPDR = (Port->PUPDR & ~(3UL << (Pin << 1U))) | (Pull << (Pin << 1U));
+        Port->MODER = (Port->MODER & ~(3UL << (Pin << 1U))) | (Mode << (Pin << 1U));
+    }
+    __set_PRIMASK(Primask);
+}
+#endif /* PECO10_LL_BUILD */
@@ -0,0 +1,176 @@
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+#include "Os_port.h"
+#if (OS_PORT == OS_PORT_POSIX)
+#include <errno.h>
+#include <time.h>
+#else
+#include "Timebase.h"
+#endif
+/*==================================================================================================
+                                           CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                              ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  LOCAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                         LOCAL FUNCTIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                         GLOBAL FUNCTIONS
+==================================================================================================*/
+#if (OS_PORT == OS_PORT_POSIX)
+void Os_Mutex_Init(Os_Mutex_Type* pMutex)
+{
+    pthread_mutexattr_t Attr;
+
+    (void)pthread_mutexattr_init(&Attr);
+    (void)pthread_mutexattr_settype(&Attr, PTHREAD_MUTEX_RECURSIVE);
+    (void)pthread_mutexattr_setprotocol(&Attr, PTHREAD_PRIO_INHERIT);
+    (void)pthread_mutex_init(pMutex, &Attr);
+    (void)pthread_mutexattr_destroy(&Attr);
+}
+
+void Os_Mutex_Lock(Os_Mutex_Type* pMutex)
+{
+    (void)pthread_mutex_lock(pMutex);
+}
+
+void Os_Mutex_Unlock(Os_Mutex_Type* pMutex)
+{
+    (void)pthread_mutex_unlock(pMutex);
+}
+
+void Os_Semaphore_Init(Os_Semaphore_Type* pSemaphore)
+{
+    (void)sem_init(pSemaphore, 0, 0U);
+}
+
+void Os_Semaphore_Give(Os_Semaphore_Type* pSemaphore)
+{
+    int Value = 0;
+
+    /* Keep it binary, a give racing this check only adds a spurious wake */
+    (void)sem_getvalue(pSemaphore, &Value);
+    if(Value <= 0)
+    {
+        (void)sem_post(pSemaphore);
+    }
+}
+
+uint8_t Os_Semaphore_Take(Os_Semaphore_Type* pSemaphore, uint32_t TimeoutUs)
+{
+    struct timespec Deadline;
+    int Status;
+
+    if(TimeoutUs == OS_WAIT_FOREVER)
+    {
+        do
+        {
+            Status = sem_wait(pSemaphore);
+        }while((Status != 0) && (errno == EINTR));
+        return (Status == 0) ? 1U : 0U;
+    }
+    (void)clock_gettime(CLOCK_REALTIME, &Deadline);
+    Deadline.tv_sec += (time_t)(TimeoutUs / 1000000U);
+    Deadline.tv_nsec += (long)(TimeoutUs % 1000000U) * 1000L;
+    if(Deadline.tv_nsec >= 1000000000L)
+    {
+        Deadline.tv_sec++;
+        Deadline.tv_nsec -= 1000000000L;
+    }
+    do
+    {
+        Status = sem_timedwait(pSemaphore, &Deadline);
+    }while((Status != 0) && (errno == EINTR));
+    return (Status == 0) ? 1U : 0U;
+}
+
+void Os_Sleep_Us(uint32_t us)
+{
+    struct timespec Time;
+
+    Time.tv_sec = (time_t)(us / 1000000U);
+    Time.tv_nsec = (long)(us % 1000000U) * 1000L;
+    (void)nanosleep(&Time, NULL);
+}
+
+#else
+void Os_Mutex_Init(Os_Mutex_Type* pMutex)
+{
+    *pMutex = 0U;
+}
+
+void Os_Mutex_Lock(Os_Mutex_Type* pMutex)
+{
+    (void)pMutex;
+}
+
+void Os_Mutex_Unlock(Os_Mutex_Type* pMutex)
+{
+    (void)pMutex;
+}
+
+void Os_Semaphore_Init(Os_Semaphore_Type* pSemaphore)
+{
+    *pSemaphore = 0U;
+}
+
+void Os_Semaphore_Give(Os_Semaphore_Type* pSemaphore)
+{
+    *pSemaphore = 1U;
+}
+
+uint8_t Os_Semaphore_Take(Os_Semaphore_Type* pSemaphore, uint32_t TimeoutUs)
+{
+    uint32_t Primask;
+    uint8_t Given;
+
+    do
+    {
+        /* Sleeps in WFI, checking the flag with interrupts masked before each sleep */
+        Timebase_Sleep_Until(Timebase_Deadline_After((TimeoutUs > TIMEBASE_MAX_WAIT_US) ? TIMEBASE_MAX_WAIT_US
+                                                                                        : TimeoutUs), pSemaphore);
+    }while((TimeoutUs == OS_WAIT_FOREVER) && (*pSemaphore == 0U));
+
+    Primask = __get_PRIMASK();
+    __disable_irq();
+    Given = *pSemaphore;
+    *pSemaphore = 0U;
+    __set_PRIMASK(Primask);
+    return Given;
+}
+
+void Os_Sleep_Us(uint32_t us)
+{
+    /* Nothing else to run, the caller's own wait sleeps in WFI */
+    (void)us;
+}
+#endif
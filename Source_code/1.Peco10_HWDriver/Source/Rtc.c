@@ -0,0 +1,261 @@
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+#include "Rtc.h"
+#include "Settings.h"
+#include "Event_bus.h"
+/*==================================================================================================
+                                           CONSTANTS
+==================================================================================================*/
+/* Days of each month, February of a leap year has one more */
+static const uint8_t RtcMonthDays[12] = {31U, 28U, 31U, 30U, 31U, 30U, 31U, 31U, 30U, 31U, 30U, 31U};
+/* Weekday offset of each month, Sakamoto's method */
+static const uint8_t RtcMonthOffset[12] = {0U, 3U, 2U, 5U, 0U, 3U, 5U, 1U, 4U, 6U, 2U, 4U};
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+#define RTC_WRITE_PROTECT_DISABLE()             do{ RTC->WPR = 0xCAU; RTC->WPR = 0x53U; }while(0)
+#define RTC_WRITE_PROTECT_ENABLE()              (RTC->WPR = 0xFFU)
+
+/* RTCSEL value selecting LSI */
+#define RTC_CLOCK_LSI                           (2UL << RCC_BDCR_RTCSEL_Pos)
+/* WUCKSEL value selecting ck_spre (1 Hz) */
+#define RTC_WAKEUP_CK_SPRE                      (4UL << RTC_CR_WUCKSEL_Pos)
+
+/* Calendar fields of TR and DR, the Settings format without century and weekday */
+#define RTC_TR_FIELDS                           (0x003F7F7FU)
+#define RTC_DR_FIELDS                           (0x00FF1F3FU)
+
+/* Subsecond ticks of the synchronous prescaler per second and per day, us per tick */
+#define RTC_TICKS_PER_SECOND                    (RTC_SYNCH_PREDIV + 1U)
+#define RTC_TICKS_PER_DAY                       (86400UL * RTC_TICKS_PER_SECOND)
+#define RTC_TICK_US                             (1000000UL / RTC_TICKS_PER_SECOND)
+#define RTC_BCD_TO_BIN(__BCD__)                 ((((__BCD__) >> 4) * 10U) + ((__BCD__) & 0x0FU))
+/*==================================================================================================
+*                                              ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  LOCAL VARIABLE DECLARATIONS
+==================================================================================================*/
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+static uint8_t Rtc_Bcd_Valid(uint32_t Bcd, uint32_t Min, uint32_t Max);
+static uint32_t Rtc_Month_Days(uint32_t Date);
+static uint32_t Rtc_Weekday(uint32_t Date);
+static void Rtc_Write_Calendar(uint32_t Date, uint32_t Time);
+static uint32_t Rtc_Get_Ticks(void);
+
+/*==================================================================================================
+*                                         LOCAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief  This function uses to check a two digit BCD field
+ */
+static uint8_t Rtc_Bcd_Valid(uint32_t Bcd, uint32_t Min, uint32_t Max)
+{
+    return (((Bcd & 0x0FU) <= 9U) && (Bcd >= Min) && (Bcd <= Max)) ? 1U : 0U;
+}
+
+/**
+ * @brief  This function uses to get the number of days in the month of a Settings format date
+ */
+static uint32_t Rtc_Month_Days(uint32_t Date)
+{
+    uint32_t Year = RTC_BCD_TO_BIN((Date >> 16) & 0xFFU);
+    uint32_t Month = RTC_BCD_TO_BIN((Date >> 8) & 0x1FU);
+
+    /* 2000 to 2099: every fourth year is a leap year, 2000 included */
+    if((Month == 2U) && ((Year % 4U) == 0U))
+    {
+        return 29U;
+    }
+    return RtcMonthDays[Month - 1U];
+}
+
+/**
+ * @brief  This function uses to get the WDU value of a Settings format date, 1 Monday to 7 Sunday
+ */
+static uint32_t Rtc_Weekday(uint32_t Date)
+{
+    uint32_t Year = 2000U + RTC_BCD_TO_BIN((Date >> 16) & 0xFFU);
+    uint32_t Month = RTC_BCD_TO_BIN((Date >> 8) & 0x1FU);
+    uint32_t Day = RTC_BCD_TO_BIN(Date & 0x3FU);
+    uint32_t Weekday;
+
+    /* January and February count as months of the year before */
+    if(Month < 3U)
+    {
+        Year--;
+    }
+    /* 0 is Sunday */
+    Weekday = (Year + (Year / 4U) - (Year / 100U) + (Year / 400U) + RtcMonthOffset[Month - 1U] + Day) % 7U;
+    return (Weekday == 0U) ? 7U : Weekday;
+}
+
+/**
+ * @brief  This function uses to load the calendar registers in initialization mode
+ */
+static void Rtc_Write_Calendar(uint32_t Date, uint32_t Time)
+{
+    RTC_WRITE_PROTECT_DISABLE();
+    RTC->ICSR |= RTC_ICSR_INIT;
+    while((RTC->ICSR & RTC_ICSR_INITF) == 0U);
+    /* Two separate writes, synchronous prescaler first */
+    RTC->PRER = RTC_SYNCH_PREDIV;
+    RTC->PRER = (RTC_ASYNCH_PREDIV << RTC_PRER_PREDIV_A_Pos) | RTC_SYNCH_PREDIV;
+    RTC->TR = Time & RTC_TR_FIELDS;
+    /* WDU 000 is forbidden */
+    RTC->DR = (Date & RTC_DR_FIELDS) | (Rtc_Weekday(Date) << RTC_DR_WDU_Pos);
+    RTC->CR &= ~RTC_CR_FMT;
+    RTC->ICSR &= ~RTC_ICSR_INIT;
+    RTC_WRITE_PROTECT_ENABLE();
+}
+
+/**
+ * @brief  This function uses to read the time of day in subsecond ticks
+ */
+static uint32_t Rtc_Get_Ticks(void)
+{
+    uint32_t Ssr;
+    uint32_t Time;
+
+    /* BYPSHAD is set, read again if the subseconds moved while TR was read */
+    do
+    {
+        Ssr = RTC->SSR;
+        Time = RTC->TR;
+    }while(Ssr != RTC->SSR);
+    /* SSR counts down from RTC_SYNCH_PREDIV */
+    return ((((RTC_BCD_TO_BIN((Time >> 16) & 0x3FU) * 60UL) + RTC_BCD_TO_BIN((Time >> 8) & 0x7FU)) * 60UL
+             + RTC_BCD_TO_BIN(Time & 0x7FU)) * RTC_TICKS_PER_SECOND) + (RTC_SYNCH_PREDIV - Ssr);
+}
+
+/*==================================================================================================
+*                                        GLOBAL FUNCTIONS
+==================================================================================================*/
+void Rtc_Init(void)
+{
+    uint32_t Date = RTC_DEFAULT_DATE;
+    uint32_t Time = RTC_DEFAULT_TIME;
+
+    RCC->APBENR1 |= RCC_APBENR1_PWREN | RCC_APBENR1_RTCAPBEN;
+    PWR->CR1 |= PWR_CR1_DBP;
+    RCC->CSR |= RCC_CSR_LSION;
+    while((RCC->CSR & RCC_CSR_LSIRDY) == 0U);
+    if((RCC->BDCR & RCC_BDCR_RTCSEL) != RTC_CLOCK_LSI)
+    {
+        /* RTCSEL can only change after a backup domain reset */
+        RCC->BDCR |= RCC_BDCR_BDRST;
+        RCC->BDCR &= ~RCC_BDCR_BDRST;
+        RCC->BDCR = (RCC->BDCR & ~RCC_BDCR_RTCSEL) | RTC_CLOCK_LSI;
+    }
+    RCC->BDCR |= RCC_BDCR_RTCEN;
+
+    if((RTC->ICSR & RTC_ICSR_INITS) == 0U)
+    {
+        /* Calendar lost with the power, restart from the last one set */
+        (void)Settings_Get(SETTINGS_KEY_CALENDAR_DATE, &Date);
+        (void)Settings_Get(SETTINGS_KEY_CALENDAR_TIME, &Time);
+        Rtc_Write_Calendar(Date, Time);
+    }
+
+    RTC_WRITE_PROTECT_DISABLE();
+    /* Read TR and DR straight from the counters, no shadow resynchronisation after Stop */
+    RTC->CR |= RTC_CR_BYPSHAD;
+    RTC->CR &= ~(RTC_CR_WUTE | RTC_CR_WUTIE);
+    while((RTC->ICSR & RTC_ICSR_WUTWF) == 0U);
+    /* ck_spre with WUTR = 0: one wake-up per second */
+    RTC->WUTR = 0U;
+    RTC->CR = (RTC->CR & ~RTC_CR_WUCKSEL) | RTC_WAKEUP_CK_SPRE;
+    RTC->SCR = RTC_SCR_CWUTF;
+    RTC->CR |= RTC_CR_WUTE | RTC_CR_WUTIE;
+    RTC_WRITE_PROTECT_ENABLE();
+
+    /* Wake-up event on EXTI direct line 19 */
+    EXTI->IMR1 |= EXTI_IMR1_IM19;
+    NVIC_SetPriority(RTC_TAMP_IRQn, 2U);
+    NVIC_EnableIRQ(RTC_TAMP_IRQn);
+}
+
+void Rtc_Get_Date_Time(uint32_t* pDate, uint32_t* pTime)
+{
+    uint32_t Time;
+    uint32_t Date;
+
+    /* BYPSHAD is set, read again if a second ticked between the two registers */
+    do
+    {
+        Time = RTC->TR;
+        Date = RTC->DR;
+    }while(Time != RTC->TR);
+    *pTime = Time & RTC_TR_FIELDS;
+    *pDate = 0x20000000U | (Date & RTC_DR_FIELDS);
+}
+
+Std_Return_Type Rtc_Set_Date_Time(uint32_t Date, uint32_t Time)
+{
+    if(((Date >> 24) != 0x20U)
+       || (Rtc_Bcd_Valid((Date >> 16) & 0xFFU, 0x00U, 0x99U) == 0U)
+       || (Rtc_Bcd_Valid((Date >> 8) & 0xFFU, 0x01U, 0x12U) == 0U)
+       || (Rtc_Bcd_Valid(Date & 0xFFU, 0x01U, 0x31U) == 0U)
+       || (RTC_BCD_TO_BIN(Date & 0xFFU) > Rtc_Month_Days(Date))
+       || (Rtc_Bcd_Valid((Time >> 16) & 0xFFU, 0x00U, 0x23U) == 0U)
+       || (Rtc_Bcd_Valid((Time >> 8) & 0xFFU, 0x00U, 0x59U) == 0U)
+       || (Rtc_Bcd_Valid(Time & 0xFFU, 0x00U, 0x59U) == 0U)
+       || ((Time >> 24) != 0U))
+    {
+        return E_NOT_OK;
+    }
+    Rtc_Write_Calendar(Date, Time);
+    (void)Settings_Set(SETTINGS_KEY_CALENDAR_DATE, Date);
+    return Settings_Set(SETTINGS_KEY_CALENDAR_TIME, Time);
+}
+
+void Rtc_Stop_Until_Wakeup(void)
+{
+    uint32_t Start = Timebase_Now();
+    uint32_t Ticks = Rtc_Get_Ticks();
+    uint32_t SleptUs;
+    uint32_t AwakeUs;
+
+    /* Stop 1: low power regulator, SRAM and registers kept, SYSCLK restarts on HSI16 */
+    PWR->CR1 = (PWR->CR1 & ~PWR_CR1_LPMS) | PWR_CR1_LPMS_0;
+    SCB->SCR |= SCB_SCR_SLEEPDEEP_Msk;
+    __DSB();
+    __WFI();
+    SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+
+    /* TIM2 stood still in Stop, add the time the RTC saw minus what TIM2 counted itself
+     * (the wake-up interrupt and the code around the WFI), within one RTC tick */
+    SleptUs = ((Rtc_Get_Ticks() + RTC_TICKS_PER_DAY - Ticks) % RTC_TICKS_PER_DAY) * RTC_TICK_US;
+    AwakeUs = Timebase_Elapsed(Start);
+    if(SleptUs > AwakeUs)
+    {
+        Timebase_Advance(SleptUs - AwakeUs);
+    }
+}
+
+/*==================================================================================================
+*                                        INTERUPT HANDLER FUNCTIONS
+==================================================================================================*/
+void Rtc_IRQHandler(void)
+{
+    if((RTC->MISR & RTC_MISR_WUTMF) != 0U)
+    {
+        RTC->SCR = RTC_SCR_CWUTF;
+        (void)Event_Publish(EVENT_RTC_SECOND, 0U);
+    }
+}
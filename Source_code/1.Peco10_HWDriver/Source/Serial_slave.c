@@ -0,0 +1,361 @@
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+#include "Serial_slave.h"
+#include "Lcd_segment.h"
+#include "Lcd_character.h"
+#include "Display_delta.h"
+#include "Rtc.h"
+#include "Event_bus.h"
+#include "Timebase.h"
+#include "Ll_init.h"
+#include "stm32g0xx_ll_dma.h"
+/*==================================================================================================
+                                           CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+#define SERIAL_DMA                              DMA1
+#define SERIAL_DMA_CHANNEL                      LL_DMA_CHANNEL_1
+
+#define SERIAL_RX_MASK                          (SERIAL_RX_BUFFER_SIZE - 1U)
+/* Byte of the ring at a free running position */
+#define SERIAL_RX_BYTE(__POS__)                 (SerialRxBuffer[(__POS__) & SERIAL_RX_MASK])
+/* Little endian 32 bit word of the ring at a free running position */
+#define SERIAL_RX_WORD(__POS__)                 ((uint32_t)SERIAL_RX_BYTE(__POS__) | \
+                                                 ((uint32_t)SERIAL_RX_BYTE((__POS__) + 1U) << 8) | \
+                                                 ((uint32_t)SERIAL_RX_BYTE((__POS__) + 2U) << 16) | \
+                                                 ((uint32_t)SERIAL_RX_BYTE((__POS__) + 3U) << 24))
+/*==================================================================================================
+*                                              ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  LOCAL VARIABLE DECLARATIONS
+==================================================================================================*/
+/* DMA circular receive buffer */
+static uint8_t SerialRxBuffer[SERIAL_RX_BUFFER_SIZE];
+
+/* Free running count of bytes written by the DMA, updated from interrupts */
+static volatile uint32_t SerialRxWriteCount = 0U;
+/* DMA ring position seen by the last interrupt */
+static uint32_t SerialRxLastPos = 0U;
+/* Free running count of bytes consumed by Serial_Slave_Process */
+static uint32_t SerialRxReadCount = 0U;
+
+/* Write counts at each idle line, written by interrupt and read by thread */
+static volatile uint32_t SerialFrameEnd[SERIAL_FRAME_QUEUE_SIZE];
+static volatile uint8_t SerialFrameHead = 0U;
+static uint8_t SerialFrameTail = 0U;
+
+static uint8_t SerialAddress = SERIAL_ADDRESS_BROADCAST;
+static uint32_t SerialFrameCount = 0U;
+static uint32_t SerialErrorCount = 0U;
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+static void Serial_Slave_Update_Write_Count(void);
+static Std_Return_Type Serial_Slave_Check_Frame(uint32_t Start, uint32_t Length);
+static void Serial_Slave_Execute(uint8_t Command, uint32_t Payload, uint8_t Length);
+
+/*==================================================================================================
+*                                         LOCAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief  This function uses to account the bytes written by the DMA since the last call
+ *
+ * @note Called from interrupt context only, at least every half buffer thanks to HT/TC
+ */
+static void Serial_Slave_Update_Write_Count(void)
+{
+    uint32_t Pos = SERIAL_RX_BUFFER_SIZE - LL_DMA_GetDataLength(SERIAL_DMA, SERIAL_DMA_CHANNEL);
+    SerialRxWriteCount += (Pos - SerialRxLastPos) & SERIAL_RX_MASK;
+    SerialRxLastPos = Pos & SERIAL_RX_MASK;
+}
+
+/**
+ * @brief  This function uses to validate a frame in place in the ring buffer
+ *
+ * @param[in]  Start   : free running position of the first byte
+ *             Length  : number of bytes between Start and the idle line
+ *
+ * @retval     E_OK when the frame is well formed and addressed to this device
+ */
+static Std_Return_Type Serial_Slave_Check_Frame(uint32_t Start, uint32_t Length)
+{
+    uint8_t Sum = 0U;
+    uint32_t i;
+    uint8_t Address;
+
+    if((Length < SERIAL_FRAME_OVERHEAD) || (SERIAL_RX_BYTE(Start) != SERIAL_FRAME_START)
+        || (Length != ((uint32_t)SERIAL_RX_BYTE(Start + 3U) + SERIAL_FRAME_OVERHEAD)))
+    {
+        SerialErrorCount++;
+        return E_NOT_OK;
+    }
+    for(i = 1U; i < Length; i++)
+    {
+        Sum += SERIAL_RX_BYTE(Start + i);
+    }
+    if(Sum != 0U)
+    {
+        SerialErrorCount++;
+        return E_NOT_OK;
+    }
+    Address = SERIAL_RX_BYTE(Start + 1U);
+    if((Address != SerialAddress) && (Address != SERIAL_ADDRESS_BROADCAST))
+    {
+        /* Valid frame for another slave */
+        return E_NOT_OK;
+    }
+    return E_OK;
+}
+
+/**
+ * @brief  This function uses to apply one command to the displays
+ *
+ * @param[in]  Command  : command code
+ *             Payload  : free running position of the first payload byte
+ *             Length   : payload length
+ */
+static void Serial_Slave_Execute(uint8_t Command, uint32_t Payload, uint8_t Length)
+{
+    uint8_t Offset;
+    uint8_t i;
+    switch(Command)
+    {
+        case SERIAL_CMD_SEGMENT_TEXT:
+            if(Length >= 1U)
+            {
+                Lcd_Segment_Put_Data_Ring(SERIAL_RX_BYTE(Payload), SerialRxBuffer, SERIAL_RX_MASK,
+                                          (uint16_t)((Payload + 1U) & SERIAL_RX_MASK), Length - 1U);
+            }
+            break;
+        case SERIAL_CMD_SEGMENT_INDICATOR:
+            if(Length >= 1U)
+            {
+                Lcd_Segment_Put_Indicator(SERIAL_RX_BYTE(Payload));
+            }
+            if(Length >= 2U)
+            {
+                Lcd_Segment_Blink_Indicator(SERIAL_RX_BYTE(Payload + 1U));
+            }
+            break;
+        case SERIAL_CMD_CHARACTER_TEXT:
+            if(Length >= 2U)
+            {
+                Offset = SERIAL_RX_BYTE(Payload + 1U);
+                if((SERIAL_RX_BYTE(Payload) >= LCD_CHARACTER_LINES) || (Offset >= LCD_CHARACTER_COLS))
+                {
+                    /* The cursor would stay where it was, the text would land there */
+                    SerialErrorCount++;
+                    break;
+                }
+                Lcd_Set_Cursor(SERIAL_RX_BYTE(Payload), Offset);
+                for(i = 2U; (i < Length) && (Offset < LCD_CHARACTER_COLS); i++, Offset++)
+                {
+                    Lcd_Put_Char(SERIAL_RX_BYTE(Payload + i));
+                }
+            }
+            break;
+        case SERIAL_CMD_CHARACTER_CLEAR:
+            Lcd_Clear();
+            break;
+        case SERIAL_CMD_DISPLAY_DELTA:
+            if(Display_Delta_Apply(SerialRxBuffer, SERIAL_RX_MASK, (uint16_t)(Payload & SERIAL_RX_MASK), Length) != E_OK)
+            {
+                SerialErrorCount++;
+            }
+            break;
+        case SERIAL_CMD_SEGMENT_POWER:
+            if(Length >= 1U)
+            {
+                if(SERIAL_RX_BYTE(Payload) == SERIAL_SEGMENT_POWER_SAVE)
+                {
+                    Lcd_Segment_Power_Save();
+                }else
+                {
+                    Lcd_Segment_Resume();
+                }
+            }
+            break;
+        case SERIAL_CMD_CALENDAR:
+            if((Length < 8U) || (Rtc_Set_Date_Time(SERIAL_RX_WORD(Payload), SERIAL_RX_WORD(Payload + 4U)) != E_OK))
+            {
+                SerialErrorCount++;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/*==================================================================================================
+*                                        GLOBAL FUNCTIONS
+==================================================================================================*/
+void Serial_Slave_Init(void)
+{
+#if (PECO10_LL_BUILD == 0U)
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+#endif
+
+    __HAL_RCC_USART2_CLK_ENABLE();
+    __HAL_RCC_DMA1_CLK_ENABLE();
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+
+    /**USART2 GPIO Configuration
+    PA2     ------> USART2_TX
+    PA3     ------> USART2_RX
+    */
+#if (PECO10_LL_BUILD == 1U)
+    Ll_Init_Gpio(SERIAL_GPIO_PORT, SERIAL_TX_PIN|SERIAL_RX_PIN, LL_INIT_GPIO_MODE_ALTERNATE, LL_INIT_GPIO_PULL_UP,
+                 GPIO_AF1_USART2);
+#else
+    GPIO_InitStruct.Pin = SERIAL_TX_PIN|SERIAL_RX_PIN;
+    GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+    GPIO_InitStruct.Pull = GPIO_PULLUP;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+    GPIO_InitStruct.Alternate = GPIO_AF1_USART2;
+    HAL_GPIO_Init(SERIAL_GPIO_PORT, &GPIO_InitStruct);
+#endif
+
+    /* DMA1 channel 1: USART2 RDR -> ring buffer, circular */
+    LL_DMA_SetPeriphRequest(SERIAL_DMA, SERIAL_DMA_CHANNEL, LL_DMAMUX_REQ_USART2_RX);
+    LL_DMA_ConfigTransfer(SERIAL_DMA, SERIAL_DMA_CHANNEL, LL_DMA_DIRECTION_PERIPH_TO_MEMORY |
+                          LL_DMA_MODE_CIRCULAR | LL_DMA_PERIPH_NOINCREMENT | LL_DMA_MEMORY_INCREMENT |
+                          LL_DMA_PDATAALIGN_BYTE | LL_DMA_MDATAALIGN_BYTE | LL_DMA_PRIORITY_HIGH);
+    LL_DMA_ConfigAddresses(SERIAL_DMA, SERIAL_DMA_CHANNEL, (uint32_t)&SERIAL_USART->RDR,
+                           (uint32_t)SerialRxBuffer, LL_DMA_DIRECTION_PERIPH_TO_MEMORY);
+    LL_DMA_SetDataLength(SERIAL_DMA, SERIAL_DMA_CHANNEL, SERIAL_RX_BUFFER_SIZE);
+    LL_DMA_EnableIT_HT(SERIAL_DMA, SERIAL_DMA_CHANNEL);
+    LL_DMA_EnableIT_TC(SERIAL_DMA, SERIAL_DMA_CHANNEL);
+    LL_DMA_EnableChannel(SERIAL_DMA, SERIAL_DMA_CHANNEL);
+
+    /* 8N1, oversampling 16, PCLK is 16 MHz in every clock mode */
+    SERIAL_USART->CR1 = 0U;
+    SERIAL_USART->BRR = (Timebase_Get_Pclk() + (SERIAL_BAUDRATE / 2U)) / SERIAL_BAUDRATE;
+    SERIAL_USART->CR3 = USART_CR3_DMAR | USART_CR3_OVRDIS;
+    SERIAL_USART->ICR = USART_ICR_IDLECF | USART_ICR_ORECF | USART_ICR_FECF | USART_ICR_NECF;
+    SERIAL_USART->CR1 = USART_CR1_UE | USART_CR1_RE | USART_CR1_IDLEIE;
+
+    NVIC_SetPriority(DMA1_Channel1_IRQn, 1U);
+    NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+    NVIC_SetPriority(USART2_IRQn, 1U);
+    NVIC_EnableIRQ(USART2_IRQn);
+}
+
+void Serial_Slave_Set_Address(uint8_t Address)
+{
+    SerialAddress = Address;
+}
+
+void Serial_Slave_Process(void)
+{
+    uint32_t End;
+    uint32_t Length;
+
+    while(SerialFrameTail != SerialFrameHead)
+    {
+        End = SerialFrameEnd[SerialFrameTail];
+        SerialFrameTail = (SerialFrameTail + 1U) % SERIAL_FRAME_QUEUE_SIZE;
+        if((SerialRxWriteCount - SerialRxReadCount) > SERIAL_RX_BUFFER_SIZE)
+        {
+            /* The DMA lapped the reader, everything up to this idle line is lost */
+            SerialErrorCount++;
+            SerialRxReadCount = End;
+            continue;
+        }
+        Length = End - SerialRxReadCount;
+        if(Serial_Slave_Check_Frame(SerialRxReadCount, Length) == E_OK)
+        {
+            SerialFrameCount++;
+            Serial_Slave_Execute(SERIAL_RX_BYTE(SerialRxReadCount + 2U), SerialRxReadCount + 4U,
+                                 SERIAL_RX_BYTE(SerialRxReadCount + 3U));
+            (void)Event_Publish(EVENT_SERIAL_FRAME, SERIAL_RX_BYTE(SerialRxReadCount + 2U));
+        }
+        SerialRxReadCount = End;
+    }
+}
+
+uint32_t Serial_Slave_Get_Frame_Count(void)
+{
+    return SerialFrameCount;
+}
+
+uint32_t Serial_Slave_Get_Error_Count(void)
+{
+    return SerialErrorCount;
+}
+
+void Serial_Slave_Wakeup_Enable(uint8_t Enable)
+{
+    if(Enable != 0U)
+    {
+        /* Port A on the line, falling edge of the start bit */
+        EXTI->EXTICR[SERIAL_RX_EXTI_LINE >> 2U] &= ~(0xFFUL << ((SERIAL_RX_EXTI_LINE & 3U) << 3U));
+        EXTI->FTSR1 |= (1UL << SERIAL_RX_EXTI_LINE);
+        EXTI->FPR1 = (1UL << SERIAL_RX_EXTI_LINE);
+        EXTI->IMR1 |= (1UL << SERIAL_RX_EXTI_LINE);
+        NVIC_SetPriority(EXTI2_3_IRQn, 1U);
+        NVIC_EnableIRQ(EXTI2_3_IRQn);
+    }else
+    {
+        EXTI->IMR1 &= ~(1UL << SERIAL_RX_EXTI_LINE);
+        EXTI->FTSR1 &= ~(1UL << SERIAL_RX_EXTI_LINE);
+        EXTI->FPR1 = (1UL << SERIAL_RX_EXTI_LINE);
+    }
+}
+
+/*==================================================================================================
+*                                        INTERUPT HANDLER FUNCTIONS
+==================================================================================================*/
+void Serial_Slave_Wakeup_IRQHandler(void)
+{
+    /* Waking up is all that is needed, Serial_Slave_Wakeup_Enable(0) disarms the line */
+    EXTI->FPR1 = (1UL << SERIAL_RX_EXTI_LINE);
+}
+
+void Serial_Slave_Usart_IRQHandler(void)
+{
+    uint8_t Next;
+    if((SERIAL_USART->ISR & USART_ISR_IDLE) != 0U)
+    {
+        SERIAL_USART->ICR = USART_ICR_IDLECF;
+        Serial_Slave_Update_Write_Count();
+        Next = (SerialFrameHead + 1U) % SERIAL_FRAME_QUEUE_SIZE;
+        if(Next != SerialFrameTail)
+        {
+            SerialFrameEnd[SerialFrameHead] = SerialRxWriteCount;
+            SerialFrameHead = Next;
+            (void)Event_Publish(EVENT_SERIAL_RECEIVED, 0U);
+        }
+    }
+    /* Line errors only corrupt the current frame, the checksum rejects it */
+    SERIAL_USART->ICR = USART_ICR_ORECF | USART_ICR_FECF | USART_ICR_NECF;
+}
+
+void Serial_Slave_Dma_IRQHandler(void)
+{
+    if(LL_DMA_IsActiveFlag_HT1(SERIAL_DMA) != 0U)
+    {
+        LL_DMA_ClearFlag_HT1(SERIAL_DMA);
+    }
+    if(LL_DMA_IsActiveFlag_TC1(SERIAL_DMA) != 0U)
+    {
+        LL_DMA_ClearFlag_TC1(SERIAL_DMA);
+    }
+    Serial_Slave_Update_Write_Count();
+}
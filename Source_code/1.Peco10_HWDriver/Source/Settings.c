@@ -0,0 +1,330 @@
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+#include "Settings.h"
+/*==================================================================================================
+                                           CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+#define SETTINGS_RECORD_SIZE                    (8U)
+#define SETTINGS_ERASED_WORD                    (0xFFFFFFFFU)
+
+#define SETTINGS_WORD(__ADDRESS__)              (*(__IO uint32_t*)(__ADDRESS__))
+#define SETTINGS_RECORD_KEY(__WORD1__)          ((uint8_t)((__WORD1__) >> 24))
+#define SETTINGS_RECORD_SEQUENCE(__WORD1__)     ((uint16_t)((__WORD1__) >> 8))
+#define SETTINGS_RECORD_CHECK(__WORD1__)        ((uint8_t)(__WORD1__))
+/*==================================================================================================
+*                                              ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  LOCAL VARIABLE DECLARATIONS
+==================================================================================================*/
+/* RAM copy of the latest value of every key */
+static uint32_t SettingsValue[SETTINGS_KEY_COUNT];
+/* Bit n set when key n has a value */
+static uint32_t SettingsValid = 0U;
+
+static uint32_t SettingsPage = SETTINGS_PAGE_A_ADDRESS;
+static uint32_t SettingsGeneration = 0U;
+/* Address of the next free record in the active page */
+static uint32_t SettingsWriteAddress = 0U;
+static uint16_t SettingsSequence = 0U;
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+static uint8_t Settings_Check(uint32_t Value, uint8_t Key, uint16_t Sequence);
+static Std_Return_Type Settings_Erase_Page(uint32_t Page);
+static Std_Return_Type Settings_Write_Record(uint32_t Address, uint32_t Word0, uint32_t Word1);
+#if (PECO10_LL_BUILD == 1U)
+static void Settings_Flash_Unlock(void);
+static Std_Return_Type Settings_Flash_Finish(uint32_t Command);
+#endif
+static Std_Return_Type Settings_Append(uint8_t Key, uint32_t Value);
+static Std_Return_Type Settings_Compact(void);
+
+/*==================================================================================================
+*                                         LOCAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief  This function uses to compute the check byte of a record
+ *
+ * @retval     check byte, never equal to the erased value for a zero record
+ */
+static uint8_t Settings_Check(uint32_t Value, uint8_t Key, uint16_t Sequence)
+{
+    uint8_t Check = 0xA5U;
+    Check ^= (uint8_t)Value ^ (uint8_t)(Value >> 8) ^ (uint8_t)(Value >> 16) ^ (uint8_t)(Value >> 24);
+    Check ^= Key ^ (uint8_t)Sequence ^ (uint8_t)(Sequence >> 8);
+    return Check;
+}
+
+#if (PECO10_LL_BUILD == 1U)
+/**
+ * @brief  This function uses to unlock FLASH_CR and clear the flags of the previous operation
+ */
+static void Settings_Flash_Unlock(void)
+{
+    while((FLASH->SR & FLASH_SR_BSY1) != 0U);
+    FLASH->SR = FLASH_SR_CLEAR;
+    if((FLASH->CR & FLASH_CR_LOCK) != 0U)
+    {
+        FLASH->KEYR = FLASH_KEY1;
+        FLASH->KEYR = FLASH_KEY2;
+    }
+}
+
+/**
+ * @brief  This function uses to wait for the end of the operation, clear Command and lock FLASH_CR
+ */
+static Std_Return_Type Settings_Flash_Finish(uint32_t Command)
+{
+    uint32_t Status;
+
+    while((FLASH->SR & FLASH_SR_BSY1) != 0U);
+    Status = FLASH->SR & FLASH_SR_ERRORS;
+    FLASH->SR = FLASH_SR_CLEAR;
+    while((FLASH->SR & FLASH_SR_CFGBSY) != 0U);
+    FLASH->CR &= ~Command;
+    FLASH->CR |= FLASH_CR_LOCK;
+    return (Status == 0U) ? E_OK : E_NOT_OK;
+}
+
+/**
+ * @brief  This function uses to erase one settings page
+ */
+static Std_Return_Type Settings_Erase_Page(uint32_t Page)
+{
+    Settings_Flash_Unlock();
+    FLASH->CR = (FLASH->CR & ~FLASH_CR_PNB) | FLASH_CR_PER
+                | (((Page - FLASH_BASE) / SETTINGS_PAGE_SIZE) << FLASH_CR_PNB_Pos);
+    FLASH->CR |= FLASH_CR_STRT;
+    return Settings_Flash_Finish(FLASH_CR_PER | FLASH_CR_PNB);
+}
+
+/**
+ * @brief  This function uses to program one double word
+ */
+static Std_Return_Type Settings_Write_Record(uint32_t Address, uint32_t Word0, uint32_t Word1)
+{
+    Settings_Flash_Unlock();
+    FLASH->CR |= FLASH_CR_PG;
+    /* Both words of the double word back to back, programming starts on the second one */
+    SETTINGS_WORD(Address) = Word0;
+    __ISB();
+    SETTINGS_WORD(Address + 4U) = Word1;
+    return Settings_Flash_Finish(FLASH_CR_PG);
+}
+#else
+/**
+ * @brief  This function uses to erase one settings page
+ */
+static Std_Return_Type Settings_Erase_Page(uint32_t Page)
+{
+    FLASH_EraseInitTypeDef EraseInit;
+    uint32_t PageError;
+    HAL_StatusTypeDef Status;
+
+    EraseInit.TypeErase = FLASH_TYPEERASE_PAGES;
+    EraseInit.Banks = FLASH_BANK_1;
+    EraseInit.Page = (Page - FLASH_BASE) / SETTINGS_PAGE_SIZE;
+    EraseInit.NbPages = 1U;
+    HAL_FLASH_Unlock();
+    Status = HAL_FLASHEx_Erase(&EraseInit, &PageError);
+    HAL_FLASH_Lock();
+    return (Status == HAL_OK) ? E_OK : E_NOT_OK;
+}
+
+/**
+ * @brief  This function uses to program one double word
+ */
+static Std_Return_Type Settings_Write_Record(uint32_t Address, uint32_t Word0, uint32_t Word1)
+{
+    HAL_StatusTypeDef Status;
+
+    HAL_FLASH_Unlock();
+    Status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD, Address, ((uint64_t)Word1 << 32) | Word0);
+    HAL_FLASH_Lock();
+    return (Status == HAL_OK) ? E_OK : E_NOT_OK;
+}
+
+#endif
+
+/**
+ * @brief  This function uses to append one record to the active page
+ */
+static Std_Return_Type Settings_Append(uint8_t Key, uint32_t Value)
+{
+    uint16_t Sequence = SettingsSequence + 1U;
+
+    if(Settings_Write_Record(SettingsWriteAddress, Value, ((uint32_t)Key << 24) | ((uint32_t)Sequence << 8)
+                             | Settings_Check(Value, Key, Sequence)) != E_OK)
+    {
+        return E_NOT_OK;
+    }
+    SettingsSequence = Sequence;
+    SettingsWriteAddress += SETTINGS_RECORD_SIZE;
+    return E_OK;
+}
+
+/**
+ * @brief  This function uses to copy the latest values into the other page and make it active
+ */
+static Std_Return_Type Settings_Compact(void)
+{
+    uint32_t NewPage = (SettingsPage == SETTINGS_PAGE_A_ADDRESS) ? SETTINGS_PAGE_B_ADDRESS : SETTINGS_PAGE_A_ADDRESS;
+    uint32_t OldWriteAddress = SettingsWriteAddress;
+    uint8_t Key;
+
+    if(Settings_Erase_Page(NewPage) != E_OK)
+    {
+        return E_NOT_OK;
+    }
+    SettingsWriteAddress = NewPage + SETTINGS_RECORD_SIZE;
+    for(Key = 0U; Key < SETTINGS_KEY_COUNT; Key++)
+    {
+        if(((SettingsValid >> Key) & 1U) != 0U)
+        {
+            if(Settings_Append(Key, SettingsValue[Key]) != E_OK)
+            {
+                break;
+            }
+        }
+    }
+    /* Header last: until here the old page is still the active one */
+    if((Key < SETTINGS_KEY_COUNT)
+        || (Settings_Write_Record(NewPage, SETTINGS_PAGE_MAGIC, SettingsGeneration + 1U) != E_OK))
+    {
+        /* The new page has no header and is ignored at boot, the old one stays full so the
+         * next Settings_Set compacts again instead of appending where nothing is read back */
+        SettingsWriteAddress = OldWriteAddress;
+        return E_NOT_OK;
+    }
+    SettingsGeneration++;
+    SettingsPage = NewPage;
+    return E_OK;
+}
+
+/*==================================================================================================
+*                                        GLOBAL FUNCTIONS
+==================================================================================================*/
+void Settings_Init(void)
+{
+    uint32_t GenerationA = SETTINGS_WORD(SETTINGS_PAGE_A_ADDRESS + 4U);
+    uint32_t GenerationB = SETTINGS_WORD(SETTINGS_PAGE_B_ADDRESS + 4U);
+    uint8_t ValidA = (SETTINGS_WORD(SETTINGS_PAGE_A_ADDRESS) == SETTINGS_PAGE_MAGIC) ? 1U : 0U;
+    uint8_t ValidB = (SETTINGS_WORD(SETTINGS_PAGE_B_ADDRESS) == SETTINGS_PAGE_MAGIC) ? 1U : 0U;
+    uint32_t Address;
+    uint32_t Word0;
+    uint32_t Word1;
+    uint8_t Key;
+    uint8_t SequenceFound = 0U;
+
+    SettingsValid = 0U;
+    if((ValidA == 0U) && (ValidB == 0U))
+    {
+        /* Blank or foreign content: start a fresh log in page A */
+        (void)Settings_Erase_Page(SETTINGS_PAGE_A_ADDRESS);
+        (void)Settings_Erase_Page(SETTINGS_PAGE_B_ADDRESS);
+        (void)Settings_Write_Record(SETTINGS_PAGE_A_ADDRESS, SETTINGS_PAGE_MAGIC, 0U);
+        SettingsPage = SETTINGS_PAGE_A_ADDRESS;
+        SettingsGeneration = 0U;
+        SettingsSequence = 0U;
+        SettingsWriteAddress = SETTINGS_PAGE_A_ADDRESS + SETTINGS_RECORD_SIZE;
+        return;
+    }
+    if((ValidB != 0U) && ((ValidA == 0U) || ((int32_t)(GenerationB - GenerationA) > 0)))
+    {
+        SettingsPage = SETTINGS_PAGE_B_ADDRESS;
+        SettingsGeneration = GenerationB;
+    }
+    else
+    {
+        SettingsPage = SETTINGS_PAGE_A_ADDRESS;
+        SettingsGeneration = GenerationA;
+    }
+
+    /* Single backward scan: the first record met for a key is its latest value */
+    SettingsWriteAddress = SettingsPage + SETTINGS_RECORD_SIZE;
+    for(Address = SettingsPage + SETTINGS_PAGE_SIZE - SETTINGS_RECORD_SIZE; Address > SettingsPage;
+        Address -= SETTINGS_RECORD_SIZE)
+    {
+        Word0 = SETTINGS_WORD(Address);
+        Word1 = SETTINGS_WORD(Address + 4U);
+        if((Word0 == SETTINGS_ERASED_WORD) && (Word1 == SETTINGS_ERASED_WORD))
+        {
+            continue;
+        }
+        if(SettingsWriteAddress == (SettingsPage + SETTINGS_RECORD_SIZE))
+        {
+            /* Last programmed slot, never reuse it even if corrupt */
+            SettingsWriteAddress = Address + SETTINGS_RECORD_SIZE;
+        }
+        Key = SETTINGS_RECORD_KEY(Word1);
+        if((Key >= SETTINGS_KEY_COUNT)
+            || (SETTINGS_RECORD_CHECK(Word1) != Settings_Check(Word0, Key, SETTINGS_RECORD_SEQUENCE(Word1))))
+        {
+            /* Record torn by a reset while programming */
+            continue;
+        }
+        if(SequenceFound == 0U)
+        {
+            SettingsSequence = SETTINGS_RECORD_SEQUENCE(Word1);
+            SequenceFound = 1U;
+        }
+        if(((SettingsValid >> Key) & 1U) == 0U)
+        {
+            SettingsValue[Key] = Word0;
+            SettingsValid |= 1UL << Key;
+            if(SettingsValid == ((1UL << SETTINGS_KEY_COUNT) - 1U))
+            {
+                break;
+            }
+        }
+    }
+}
+
+Std_Return_Type Settings_Get(Settings_Key_Type Key, uint32_t* pValue)
+{
+    if((Key >= SETTINGS_KEY_COUNT) || (((SettingsValid >> Key) & 1U) == 0U))
+    {
+        return E_NOT_OK;
+    }
+    *pValue = SettingsValue[Key];
+    return E_OK;
+}
+
+Std_Return_Type Settings_Set(Settings_Key_Type Key, uint32_t Value)
+{
+    if(Key >= SETTINGS_KEY_COUNT)
+    {
+        return E_NOT_OK;
+    }
+    if((((SettingsValid >> Key) & 1U) != 0U) && (SettingsValue[Key] == Value))
+    {
+        /* Unchanged, save a flash write */
+        return E_OK;
+    }
+    SettingsValue[Key] = Value;
+    SettingsValid |= 1UL << Key;
+    if(SettingsWriteAddress >= (SettingsPage + SETTINGS_PAGE_SIZE))
+    {
+        /* The compacted page already holds the new value */
+        return Settings_Compact();
+    }
+    return Settings_Append((uint8_t)Key, Value);
+}
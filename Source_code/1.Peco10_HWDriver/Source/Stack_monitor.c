@@ -0,0 +1,79 @@
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+#include "Stack_monitor.h"
+/*==================================================================================================
+                                           CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+/* Bounds of the STACK area of startup_stm32g031xx.s, defined by armlink for each section name */
+#define STACK_MONITOR_BASE                      ((uint32_t*)&STACK$$Base)
+#define STACK_MONITOR_LIMIT                     ((uint32_t*)&STACK$$Limit)
+/*==================================================================================================
+*                                              ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  LOCAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+extern uint32_t STACK$$Base;
+extern uint32_t STACK$$Limit;
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                         LOCAL FUNCTIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                         GLOBAL FUNCTIONS
+==================================================================================================*/
+void Stack_Monitor_Init(void)
+{
+    uint32_t* pWord = STACK_MONITOR_BASE;
+    /* The frames above the stack pointer are live */
+    uint32_t* pEnd = (uint32_t*)((__get_MSP() - STACK_MONITOR_MARGIN) & ~3UL);
+
+    while(pWord < pEnd)
+    {
+        *pWord = STACK_MONITOR_PAINT;
+        pWord++;
+    }
+}
+
+uint32_t Stack_Monitor_Get_High_Water(void)
+{
+    const uint32_t* pWord = STACK_MONITOR_BASE;
+
+    /* The stack grows down, the first word changed from the bottom is the deepest one used */
+    while((pWord < STACK_MONITOR_LIMIT) && (*pWord == STACK_MONITOR_PAINT))
+    {
+        pWord++;
+    }
+    return (uint32_t)STACK_MONITOR_LIMIT - (uint32_t)pWord;
+}
+
+uint32_t Stack_Monitor_Get_Size(void)
+{
+    return (uint32_t)STACK_MONITOR_LIMIT - (uint32_t)STACK_MONITOR_BASE;
+}
+
+Std_Return_Type Stack_Monitor_Check(void)
+{
+    return (Stack_Monitor_Get_High_Water() > (Stack_Monitor_Get_Size() - STACK_MONITOR_GUARD_BYTES)) ? E_NOT_OK : E_OK;
+}
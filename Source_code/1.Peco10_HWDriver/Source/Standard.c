@@ -12,6 +12,10 @@
 /*==================================================================================================
                                        DEFINES AND MACROS
 ==================================================================================================*/
+/* IC_74hc595_Bit_Operation operations */
+#define IC_74HC595_BIT_CLEAR        0U
+#define IC_74HC595_BIT_SET          1U
+#define IC_74HC595_BIT_TOGGLE       2U
 
 /*==================================================================================================
 *                                              ENUMS
@@ -28,19 +32,35 @@
 /*==================================================================================================
 *                                  GLOBAL VARIABLE DECLARATIONS
 ==================================================================================================*/
-/* Variable to store pin state of the 74HC595 for Lcd character*/
-static volatile uint8_t Current_74HC595_Lcd_Data_Out = 0U;
+/* Output image of each 74HC595 stage, indexed by Device_Type then extra stages, owned by the arbiter */
+static volatile uint8_t Ic74hc595Image[IC_74HC595_STAGES] = {0x00U, DUMMY_DATA};
+/* Set when an image changed since the last snapshot */
+static volatile uint8_t Ic74hc595Dirty = 0U;
+/* Set while a context is shifting the chain */
+static volatile uint8_t Ic74hc595Busy = 0U;
+/* Threads latch one after the other, so a change is latched on return from thread context */
+static Os_Mutex_Type Ic74hc595Mutex;
+/* Select lines and read of the 74LS151 in one step */
+static Os_Mutex_Type Ic74ls151Mutex;
 /*==================================================================================================
 *                                       FUNCTION PROTOTYPES
 ==================================================================================================*/
-
+static Std_Return_Type IC_74hc595_Commit(void);
+static Std_Return_Type IC_74hc595_Bit_Operation(uint16_t Output, uint8_t Operation);
 
 /*==================================================================================================
 *                                         LOCAL FUNCTIONS
 ==================================================================================================*/
+void Standard_Init(void)
+{
+    Os_Mutex_Init(&Ic74hc595Mutex);
+    Os_Mutex_Init(&Ic74ls151Mutex);
+}
+
 void IC_74hc595(uint8_t data)
 {
     uint8_t i;
+    TRACE_ENTER(TRACE_ID_SHIFT_OUT);
     SHCP_CLR;
     for(i=0;i<8;i++)
     {
@@ -51,34 +71,190 @@ void IC_74hc595(uint8_t data)
         {
             DS_SET;
         }
+        /* DS setup time, then SHCP high time. Its low time is the next DS write and wait */
+        IC_74HC595_TW_WAIT();
         SHCP_SET;
+        IC_74HC595_TW_WAIT();
         SHCP_CLR;
         data = data << 1;
     }
+    TRACE_EXIT(TRACE_ID_SHIFT_OUT);
 }
 
 
 void IC_74hc595_Output(void)
 {
+    /* SHCP to STCP setup time, then STCP high time. A few cycles, no timer wait: the BCM
+     * interrupt latches through here */
     STCP_CLR;
-    udelay(5);
+    IC_74HC595_TW_WAIT();
     STCP_SET;
+    IC_74HC595_TW_WAIT();
     STCP_CLR;
 }
 
 void IC_74hc595_Send_Data(uint8_t data, Device_Type Component)
 {
-    if(Component == LCD_CHARACTER)
+    (void)IC_74hc595_Transaction(Component, 0xFFU, data);
+}
+
+/**
+ * @brief Shift out the images until no change is pending, by the first context that gets the chain
+ *
+ * @return E_OK when the pending changes are latched on return,
+ *         E_NOT_OK when a preempted shift owns the chain and will latch them
+ */
+static Std_Return_Type IC_74hc595_Commit(void)
+{
+    uint32_t Primask;
+    uint8_t Owner;
+    uint8_t Stage;
+    uint8_t Image[IC_74HC595_STAGES];
+
+    /* A thread preempting the owner waits for it, an interrupt never waits */
+    Os_Mutex_Lock(&Ic74hc595Mutex);
+    Primask = __get_PRIMASK();
+    __disable_irq();
+    Owner = (Ic74hc595Busy == 0U) ? 1U : 0U;
+    Ic74hc595Busy = 1U;
+    __set_PRIMASK(Primask);
+
+    if(Owner == 0U)
+    {
+        /* Preempted shift in progress, its owner latches this change in its next cycle */
+        Os_Mutex_Unlock(&Ic74hc595Mutex);
+        return E_NOT_OK;
+    }
+    for(;;)
+    {
+        __disable_irq();
+        if(Ic74hc595Dirty == 0U)
+        {
+            /* Released in the same critical section as the last check, no change can be lost */
+            Ic74hc595Busy = 0U;
+            __set_PRIMASK(Primask);
+            break;
+        }
+        Ic74hc595Dirty = 0U;
+        for(Stage = 0U; Stage < IC_74HC595_STAGES; Stage++)
+        {
+            Image[Stage] = Ic74hc595Image[Stage];
+        }
+        __set_PRIMASK(Primask);
+
+        /* Far stage first: every change posted up to the snapshot goes out in this latch cycle */
+        for(Stage = IC_74HC595_STAGES; Stage > 0U; Stage--)
+        {
+            IC_74hc595(Image[Stage - 1U]);
+        }
+        IC_74hc595_Output();
+        TRACE_INSTANT(TRACE_ID_595_LATCH, ((uint16_t)Image[KEYPAD] << 8) | Image[LCD_CHARACTER]);
+    }
+    Os_Mutex_Unlock(&Ic74hc595Mutex);
+    return E_OK;
+}
+
+/**
+ * @brief Change one output in the image, IC_74HC595_BIT_xxx operation, without shifting
+ */
+static Std_Return_Type IC_74hc595_Bit_Operation(uint16_t Output, uint8_t Operation)
+{
+    uint32_t Primask;
+    uint8_t Stage = (uint8_t)(Output >> 3U);
+    uint8_t Bit = (uint8_t)(1U << (Output & 0x07U));
+
+    if(Output >= IC_74HC595_OUTPUTS)
+    {
+        return E_NOT_OK;
+    }
+    Primask = __get_PRIMASK();
+    __disable_irq();
+    if(Operation == IC_74HC595_BIT_SET)
+    {
+        Ic74hc595Image[Stage] |= Bit;
+    }
+    else if(Operation == IC_74HC595_BIT_CLEAR)
+    {
+        Ic74hc595Image[Stage] &= (uint8_t)~Bit;
+    }
+    else
+    {
+        Ic74hc595Image[Stage] ^= Bit;
+    }
+    Ic74hc595Dirty = 1U;
+    __set_PRIMASK(Primask);
+    return E_OK;
+}
+
+Std_Return_Type IC_74hc595_Transaction(Device_Type Component, uint8_t Mask, uint8_t Value)
+{
+    uint32_t Primask;
+    Std_Return_Type Status;
+
+    TRACE_ENTER(TRACE_ID_595_SEND_DATA);
+    Primask = __get_PRIMASK();
+    __disable_irq();
+    Ic74hc595Image[Component] = (Ic74hc595Image[Component] & (uint8_t)~Mask) | (Value & Mask);
+    Ic74hc595Dirty = 1U;
+    __set_PRIMASK(Primask);
+
+    Status = IC_74hc595_Commit();
+    TRACE_EXIT(TRACE_ID_595_SEND_DATA);
+    return Status;
+}
+
+Std_Return_Type IC_74hc595_Write_Chain(const uint8_t* pMask, const uint8_t* pValue)
+{
+    uint32_t Primask;
+    uint8_t Stage;
+
+    Primask = __get_PRIMASK();
+    __disable_irq();
+    for(Stage = 0U; Stage < IC_74HC595_STAGES; Stage++)
     {
-        Current_74HC595_Lcd_Data_Out = data;
-        IC_74hc595(DUMMY_DATA);
-        IC_74hc595(data);
-    }else if(Component == KEYPAD)
+        Ic74hc595Image[Stage] = (Ic74hc595Image[Stage] & (uint8_t)~pMask[Stage]) | (pValue[Stage] & pMask[Stage]);
+    }
+    Ic74hc595Dirty = 1U;
+    __set_PRIMASK(Primask);
+    return IC_74hc595_Commit();
+}
+
+Std_Return_Type IC_74hc595_Set_Bit(uint16_t Output)
+{
+    return IC_74hc595_Bit_Operation(Output, IC_74HC595_BIT_SET);
+}
+
+Std_Return_Type IC_74hc595_Clear_Bit(uint16_t Output)
+{
+    return IC_74hc595_Bit_Operation(Output, IC_74HC595_BIT_CLEAR);
+}
+
+Std_Return_Type IC_74hc595_Toggle_Bit(uint16_t Output)
+{
+    return IC_74hc595_Bit_Operation(Output, IC_74HC595_BIT_TOGGLE);
+}
+
+uint8_t IC_74hc595_Get_Bit(uint16_t Output)
+{
+    if(Output >= IC_74HC595_OUTPUTS)
     {
-        IC_74hc595(data);
-        IC_74hc595(Current_74HC595_Lcd_Data_Out);
+        return 0U;
     }
-    IC_74hc595_Output();
+    return ((Ic74hc595Image[Output >> 3U] & (1U << (Output & 0x07U))) != 0U) ? 1U : 0U;
+}
+
+Std_Return_Type IC_74hc595_Flush(void)
+{
+    if(Ic74hc595Dirty == 0U)
+    {
+        return E_OK;
+    }
+    return IC_74hc595_Commit();
+}
+
+uint8_t IC_74hc595_Get_Image(Device_Type Component)
+{
+    return Ic74hc595Image[Component];
 }
 
 
@@ -89,11 +265,13 @@ GPIO_PinState IC_74ls151(uint8_t Select_Input)
     GPIO_PinState B_State = (GPIO_PinState)((Select_Input & 0x02) >> 1);
     GPIO_PinState C_State = (GPIO_PinState)((Select_Input & 0x04) >> 2);
     
-    HAL_GPIO_WritePin(A_PORT,A_PIN,A_State);
-    HAL_GPIO_WritePin(B_PORT,B_PIN,B_State);
-    HAL_GPIO_WritePin(C_PORT,C_PIN,C_State);
+    Os_Mutex_Lock(&Ic74ls151Mutex);
+    STD_GPIO_WRITE(A_PORT,A_PIN,A_State);
+    STD_GPIO_WRITE(B_PORT,B_PIN,B_State);
+    STD_GPIO_WRITE(C_PORT,C_PIN,C_State);
     
-    temp = HAL_GPIO_ReadPin(Y_PORT,Y_PIN);
+    temp = STD_GPIO_READ(Y_PORT,Y_PIN);
+    Os_Mutex_Unlock(&Ic74ls151Mutex);
     return temp;
 }
 
@@ -104,12 +282,10 @@ uint8_t DecToString(uint8_t *pData,uint32_t number)
 
 void udelay(uint32_t us)
 {
-    __HAL_TIM_SET_COUNTER(&htim2,0);  // set the counter value a 0
-	while (__HAL_TIM_GET_COUNTER(&htim2) < us);  // wait for the counter to reach the us input in the parameter
+    Timebase_Wait_Until(Timebase_Deadline_After(us));
 }
 
 void mdelay(uint32_t ms)
 {
-    __HAL_TIM_SET_COUNTER(&htim2,0);  // set the counter value a 0
-	while (__HAL_TIM_GET_COUNTER(&htim2) < (ms*1000));  // wait for the counter to reach the us input in the parameter
+    Timebase_Wait_Until(Timebase_Deadline_After(ms*1000U));
 }
@@ -0,0 +1,306 @@
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+#include "Timebase.h"
+#include "Trace.h"
+#if (PECO10_LL_BUILD == 1U)
+#include "stm32g0xx_ll_rcc.h"
+#endif
+/*==================================================================================================
+                                           CONSTANTS
+==================================================================================================*/
+
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+#define TIMEBASE_TIMER                      TIM2
+
+/*==================================================================================================
+*                                              ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  LOCAL VARIABLE DECLARATIONS
+==================================================================================================*/
+static Timebase_Clock_Mode_Type Timebase_Clock_Mode = TIMEBASE_CLOCK_SLOW;
+
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+
+/*==================================================================================================
+*                                         LOCAL FUNCTIONS
+==================================================================================================*/
+/**
+ * @brief  This function uses to get the SPI1 baud rate control bits keeping the bit rate
+ *         below TIMEBASE_SPI_MAX_BITRATE
+ *
+ * @param[in]  Clock    : SPI1 kernel clock (PCLK)
+ *
+ * @retval     uint32_t value of the CR1 BR field
+ */
+static uint32_t Timebase_Spi_Baudrate(uint32_t Clock)
+{
+    uint32_t Br = 0U;
+    /* Bit rate is PCLK / 2^(BR + 1) */
+    while(((Clock >> (Br + 1U)) > TIMEBASE_SPI_MAX_BITRATE) && (Br < 7U))
+    {
+        Br++;
+    }
+    return (Br << SPI_CR1_BR_Pos);
+}
+
+/*==================================================================================================
+*                                        GLOBAL FUNCTIONS
+==================================================================================================*/
+void Timebase_Init(void)
+{
+    Timebase_Update_Prescalers();
+#if (PECO10_LL_BUILD == 1U)
+    TIMEBASE_TIMER->CR1 |= TIM_CR1_CEN;
+#else
+    HAL_TIM_Base_Start(&htim2);
+#endif
+}
+
+uint32_t Timebase_Now(void)
+{
+    /* A single 32 bits read of the counter is atomic */
+    return TIMEBASE_TIMER->CNT;
+}
+
+uint32_t Timebase_Deadline_After(uint32_t us)
+{
+    return Timebase_Now() + us;
+}
+
+uint8_t Timebase_Expired(uint32_t Deadline)
+{
+    return (uint8_t)((int32_t)(Timebase_Now() - Deadline) >= 0);
+}
+
+uint32_t Timebase_Elapsed(uint32_t Start)
+{
+    return Timebase_Now() - Start;
+}
+
+void Timebase_Wait_Until(uint32_t Deadline)
+{
+    uint32_t primask;
+    uint32_t Remaining = Deadline - Timebase_Now();
+    if((int32_t)Remaining <= 0)
+    {
+        /* Already passed: Remaining wrapped to about 4e9 us, nothing to wait */
+        return;
+    }
+    TRACE_SPAN_ENTER(TRACE_ID_WAIT, (Remaining > 0xFFFFU) ? 0xFFFFU : Remaining);
+    if((Remaining >= TIMEBASE_SLEEP_THRESHOLD_US) && (__get_IPSR() == 0U))
+    {
+        TIMEBASE_TIMER->SR = ~TIM_SR_CC1IF;
+        TIMEBASE_TIMER->DIER |= TIM_DIER_CC1IE;
+        while(Timebase_Expired(Deadline) == 0U)
+        {
+            /* Rearm the compare each pass, the channel is only owned by thread context */
+            TIMEBASE_TIMER->CCR1 = Deadline;
+            /* Mask interrupts so the compare event can not slip in between the check and WFI,
+             * a pending interrupt still wakes the core */
+            primask = __get_PRIMASK();
+            __disable_irq();
+            if(Timebase_Expired(Deadline) == 0U)
+            {
+                __WFI();
+            }
+            __set_PRIMASK(primask);
+        }
+        TIMEBASE_TIMER->DIER &= ~TIM_DIER_CC1IE;
+    }
+    while(Timebase_Expired(Deadline) == 0U);
+    TRACE_EXIT(TRACE_ID_WAIT);
+}
+
+void Timebase_Sleep_Until(uint32_t Deadline, const volatile uint8_t* pWake)
+{
+    uint32_t primask;
+
+    TIMEBASE_TIMER->SR = ~TIM_SR_CC1IF;
+    TIMEBASE_TIMER->DIER |= TIM_DIER_CC1IE;
+    while((*pWake == 0U) && (Timebase_Expired(Deadline) == 0U))
+    {
+        TIMEBASE_TIMER->CCR1 = Deadline;
+        primask = __get_PRIMASK();
+        __disable_irq();
+        if((*pWake == 0U) && (Timebase_Expired(Deadline) == 0U))
+        {
+            __WFI();
+        }
+        __set_PRIMASK(primask);
+    }
+    TIMEBASE_TIMER->DIER &= ~TIM_DIER_CC1IE;
+}
+
+void Timebase_Advance(uint32_t us)
+{
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    /* The compares move along with the counter, their remaining time is kept */
+    TIMEBASE_TIMER->CNT += us;
+    TIMEBASE_TIMER->CCR1 += us;
+    TIMEBASE_TIMER->CCR2 += us;
+    __set_PRIMASK(primask);
+}
+
+void Timebase_Update_Prescalers(void)
+{
+    uint32_t Pclk = Timebase_Get_Pclk();
+    uint32_t TimerClock = ((RCC->CFGR & RCC_CFGR_PPRE_2) == 0U) ? Pclk : (Pclk << 1U);
+    uint32_t Prescaler = TIMEBASE_PRESCALER(TimerClock);
+    uint32_t Count;
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    /* PSC is preloaded, force an update event and put back the counter value it clears */
+    Count = TIM2->CNT;
+    TIM2->PSC = Prescaler;
+    TIM2->EGR = TIM_EGR_UG;
+    TIM2->CNT = Count;
+    TIM2->SR = ~TIM_SR_UIF;
+
+    /* Running, the preloaded PSC applies at the end of the current PWM period: an UG would cut
+     * the period short and, with UIE on, count an extra fade step */
+    TIM1->PSC = Prescaler;
+    if((TIM1->CR1 & TIM_CR1_CEN) == 0U)
+    {
+        /* Stopped, load it now without setting UIF */
+        TIM1->CR1 |= TIM_CR1_URS;
+        TIM1->EGR = TIM_EGR_UG;
+        TIM1->CR1 &= ~TIM_CR1_URS;
+    }
+    __set_PRIMASK(primask);
+
+    /* BR must only change while SPI1 is disabled, the next transfer enables it again.
+     * A segment LCD DMA chain keeps TXDMAEN set until its last frame is out */
+    while(((SPI1->CR2 & SPI_CR2_TXDMAEN) != 0U) || ((SPI1->SR & SPI_SR_BSY) != 0U));
+    SPI1->CR1 &= ~SPI_CR1_SPE;
+    SPI1->CR1 = (SPI1->CR1 & ~SPI_CR1_BR_Msk) | Timebase_Spi_Baudrate(Pclk);
+#if (PECO10_LL_BUILD == 0U)
+    /* Keep the HAL handles in line in case an MX_*_Init runs again */
+    htim2.Init.Prescaler = Prescaler;
+    htim1.Init.Prescaler = Prescaler;
+    hspi1.Init.BaudRatePrescaler = Timebase_Spi_Baudrate(Pclk);
+#endif
+}
+
+uint32_t Timebase_Get_Pclk(void)
+{
+    /* Same computation as HAL_RCC_GetPCLK1Freq, HCLK is SYSCLK in both clock modes */
+    return SystemCoreClock >> (APBPrescTable[(RCC->CFGR & RCC_CFGR_PPRE) >> RCC_CFGR_PPRE_Pos] & 0x1FU);
+}
+
+#if (PECO10_LL_BUILD == 1U)
+void Timebase_Set_Clock_Mode(Timebase_Clock_Mode_Type Mode)
+{
+    if(Mode == Timebase_Clock_Mode)
+    {
+        return;
+    }
+    if(Mode == TIMEBASE_CLOCK_FAST)
+    {
+        /* Lock the PLL on HSI16 then move SYSCLK to 64 MHz with 2 flash wait states, PCLK stays 16 MHz */
+        LL_RCC_PLL_ConfigDomain_SYS(LL_RCC_PLLSOURCE_HSI, LL_RCC_PLLM_DIV_1, 8U, LL_RCC_PLLR_DIV_2);
+        LL_RCC_PLL_EnableDomain_SYS();
+        LL_RCC_PLL_Enable();
+        while(LL_RCC_PLL_IsReady() == 0U);
+        FLASH->ACR = (FLASH->ACR & ~FLASH_ACR_LATENCY) | FLASH_ACR_LATENCY_1;
+        while((FLASH->ACR & FLASH_ACR_LATENCY) != FLASH_ACR_LATENCY_1);
+        LL_RCC_SetAPB1Prescaler(LL_RCC_APB1_DIV_4);
+        LL_RCC_SetSysClkSource(LL_RCC_SYS_CLKSOURCE_PLL);
+        while(LL_RCC_GetSysClkSource() != LL_RCC_SYS_CLKSOURCE_STATUS_PLL);
+        SystemCoreClock = TIMEBASE_FAST_CLOCK_HZ;
+    }else
+    {
+        /* Back to HSI16 with no wait state, the PLL is stopped to save power */
+        LL_RCC_SetSysClkSource(LL_RCC_SYS_CLKSOURCE_HSI);
+        while(LL_RCC_GetSysClkSource() != LL_RCC_SYS_CLKSOURCE_STATUS_HSI);
+        LL_RCC_SetAPB1Prescaler(LL_RCC_APB1_DIV_1);
+        FLASH->ACR &= ~FLASH_ACR_LATENCY;
+        LL_RCC_PLL_Disable();
+        while(LL_RCC_PLL_IsReady() != 0U);
+        SystemCoreClock = HSI_VALUE;
+    }
+    Timebase_Clock_Mode = Mode;
+    Timebase_Update_Prescalers();
+}
+#else
+void Timebase_Set_Clock_Mode(Timebase_Clock_Mode_Type Mode)
+{
+    RCC_OscInitTypeDef RCC_OscInitStruct = {0};
+    RCC_ClkInitTypeDef RCC_ClkInitStruct = {0};
+
+    if(Mode == Timebase_Clock_Mode)
+    {
+        return;
+    }
+    RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK|RCC_CLOCKTYPE_SYSCLK
+                                |RCC_CLOCKTYPE_PCLK1;
+    RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
+    RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV1;
+    RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+    if(Mode == TIMEBASE_CLOCK_FAST)
+    {
+        /* Lock the PLL on HSI16 then move SYSCLK to 64 MHz with 2 flash wait states, PCLK stays 16 MHz */
+        RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
+        RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
+        RCC_OscInitStruct.PLL.PLLM = RCC_PLLM_DIV1;
+        RCC_OscInitStruct.PLL.PLLN = 8;
+        RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV2;
+#if defined(RCC_PLLQ_SUPPORT)
+        RCC_OscInitStruct.PLL.PLLQ = RCC_PLLQ_DIV2;
+#endif /* RCC_PLLQ_SUPPORT */
+        RCC_OscInitStruct.PLL.PLLR = RCC_PLLR_DIV2;
+        if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+        {
+            Error_Handler();
+        }
+        RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+        RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV4;
+        if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+        {
+            Error_Handler();
+        }
+    }else
+    {
+        /* Back to HSI16 with no wait state, the PLL is stopped to save power */
+        RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_HSI;
+        if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_0) != HAL_OK)
+        {
+            Error_Handler();
+        }
+        RCC_OscInitStruct.PLL.PLLState = RCC_PLL_OFF;
+        if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+        {
+            Error_Handler();
+        }
+    }
+    Timebase_Clock_Mode = Mode;
+    Timebase_Update_Prescalers();
+}
+#endif
+
+Timebase_Clock_Mode_Type Timebase_Get_Clock_Mode(void)
+{
+    return Timebase_Clock_Mode;
+}
@@ -0,0 +1,141 @@
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+#include "Trace.h"
+#include "Timebase.h"
+#include <stdio.h>
+#include <string.h>
+/*==================================================================================================
+                                           CONSTANTS
+==================================================================================================*/
+#if (TRACE_ENABLE == 1U)
+/**
+ * @brief Names printed in the dump, indexed by Trace_Id_Type
+ */
+static const char* const TraceName[TRACE_ID_COUNT] =
+{
+    "IC_74hc595",
+    "IC_74hc595_Transaction",
+    "Lcd_Frame_Transfer",
+    "Lcd_Segment_Display_App",
+    "Keypad_Scan",
+    "Config_Switch_Get_Value",
+    "lcd_enable",
+    "Lcd_Put_Char",
+    "595_Latch",
+    "SPI_Transfer",
+    "LCD_SCE",
+    "Busy_Wait",
+    "Keypad_Row",
+    "HD44780_Command",
+    "Boot_Milestone",
+    "Event"
+};
+#endif
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                              ENUMS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  LOCAL VARIABLE DECLARATIONS
+==================================================================================================*/
+
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+#if (TRACE_ENABLE == 1U)
+/* Not static so the debugger can find it by symbol */
+Trace_Buffer_Type Trace_Buffer;
+#endif
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+#if (TRACE_ENABLE == 1U)
+static void Trace_Put_String(void (*pPutChar)(uint8_t Data), const char* pString);
+#endif
+/*==================================================================================================
+*                                         LOCAL FUNCTIONS
+==================================================================================================*/
+#if (TRACE_ENABLE == 1U)
+static void Trace_Put_String(void (*pPutChar)(uint8_t Data), const char* pString)
+{
+    while(*pString != '\0')
+    {
+        pPutChar((uint8_t)*pString++);
+    }
+}
+#endif
+/*==================================================================================================
+*                                        GLOBAL FUNCTIONS
+==================================================================================================*/
+void Trace_Init(void)
+{
+#if (TRACE_ENABLE == 1U)
+    memset(&Trace_Buffer, 0U, sizeof(Trace_Buffer));
+    Trace_Buffer.Magic = TRACE_MAGIC;
+    Trace_Buffer.Size = TRACE_BUFFER_SIZE;
+#endif
+}
+
+void Trace_Record(uint8_t Id, uint8_t Event, uint16_t Data)
+{
+#if (TRACE_ENABLE == 1U)
+    Trace_Record_Type* pRecord;
+    uint32_t primask;
+
+    /* Reserve the slot atomically, an interrupt may trace in between */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    pRecord = &Trace_Buffer.Record[Trace_Buffer.Head & (TRACE_BUFFER_SIZE - 1U)];
+    Trace_Buffer.Head++;
+    pRecord->Timestamp = Timebase_Now();
+    pRecord->Id = Id;
+    pRecord->Event = Event;
+    pRecord->Data = Data;
+    __set_PRIMASK(primask);
+#else
+    (void)Id;
+    (void)Event;
+    (void)Data;
+#endif
+}
+
+void Trace_Dump(void (*pPutChar)(uint8_t Data))
+{
+#if (TRACE_ENABLE == 1U)
+    char Line[48];
+    uint32_t Head = Trace_Buffer.Head;
+    uint32_t Count = (Head < TRACE_BUFFER_SIZE) ? Head : TRACE_BUFFER_SIZE;
+    uint32_t i;
+    Trace_Record_Type* pRecord;
+
+    for(i = 0U; i < TRACE_ID_COUNT; i++)
+    {
+        sprintf(Line, "N,%u,", (unsigned int)i);
+        Trace_Put_String(pPutChar, Line);
+        Trace_Put_String(pPutChar, TraceName[i]);
+        pPutChar((uint8_t)'\n');
+    }
+    for(i = Head - Count; i != Head; i++)
+    {
+        pRecord = &Trace_Buffer.Record[i & (TRACE_BUFFER_SIZE - 1U)];
+        sprintf(Line, "R,%lu,%u,%c,%u\n", (unsigned long)pRecord->Timestamp, (unsigned int)pRecord->Id,
+                (pRecord->Event == TRACE_EVENT_ENTER) ? 'E' : ((pRecord->Event == TRACE_EVENT_EXIT) ? 'X' : 'I'),
+                (unsigned int)pRecord->Data);
+        Trace_Put_String(pPutChar, Line);
+    }
+#else
+    (void)pPutChar;
+#endif
+}
@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+"""Reference encoder/decoder for the display-delta batch (see Include/Display_delta.h).
+
+A batch is a run of records followed by the little endian CRC-32/MPEG-2 of the records,
+the same value the STM32G0 CRC unit produces in its reset configuration.
+
+  display_delta.py encode <record> [<record> ...]   print the batch as hex
+  display_delta.py decode <hex>                     list the records of a batch
+
+Records on the command line:
+  ram:<offset>:<hexbytes>          raw LcdDisplayRam patch
+  num:<line>:<value>[:<decimals>[:comma]]
+  ind:<byte>
+  chr:<line>:<column>:<text>
+"""
+import struct
+import sys
+
+RAM_PATCH = 0x01
+NUMBER = 0x02
+INDICATOR = 0x03
+CHARACTER_CELLS = 0x04
+
+NUMBER_DECIMAL_MASK = 0x07
+NUMBER_COMMA = 0x80
+
+# LCD_SEGMENT_DRIVER_COUNT: offsets and lines run across the driver chips
+SEGMENT_DRIVERS = 1
+DISPLAY_RAM_SIZE = 35 * SEGMENT_DRIVERS
+SEGMENT_LINES = 3 * SEGMENT_DRIVERS
+SEGMENT_COLS = 7
+# LCD_CHARACTER_LINES and LCD_CHARACTER_COLS of Lcd_character.h
+CHARACTER_LINES = 2
+CHARACTER_COLS = 16
+
+
+def crc32_mpeg2(data):
+    crc = 0xFFFFFFFF
+    for byte in data:
+        crc ^= byte << 24
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x04C11DB7) if crc & 0x80000000 else (crc << 1)
+            crc &= 0xFFFFFFFF
+    return crc
+
+
+def ram_patch(offset, data):
+    data = bytes(data)
+    if offset + len(data) > DISPLAY_RAM_SIZE:
+        raise ValueError("RAM patch past LcdDisplayRam")
+    return bytes([RAM_PATCH, offset, len(data)]) + data
+
+
+def number(line, value, decimals=0, comma=False):
+    if line >= SEGMENT_LINES or decimals >= SEGMENT_COLS:
+        raise ValueError("bad line or decimal place")
+    fmt = decimals | (NUMBER_COMMA if comma else 0)
+    return bytes([NUMBER, line, fmt]) + struct.pack("<i", value)
+
+
+def indicator(value):
+    return bytes([INDICATOR, value & 0xFF])
+
+
+def character_cells(line, column, text):
+    text = bytes(text)
+    if line >= CHARACTER_LINES or column + len(text) > CHARACTER_COLS:
+        raise ValueError("cells past the character LCD")
+    return bytes([CHARACTER_CELLS, line, column, len(text)]) + text
+
+
+def encode(records):
+    body = b"".join(records)
+    return body + struct.pack("<I", crc32_mpeg2(body))
+
+
+def decode(batch):
+    """Return the records of a batch as tuples, raise ValueError like the firmware rejects it."""
+    batch = bytes(batch)
+    if len(batch) < 4:
+        raise ValueError("short batch")
+    body, (crc,) = batch[:-4], struct.unpack("<I", batch[-4:])
+    if crc32_mpeg2(body) != crc:
+        raise ValueError("CRC mismatch")
+    records, pos = [], 0
+    while pos < len(body):
+        kind = body[pos]
+        if kind == RAM_PATCH and pos + 3 <= len(body):
+            offset, count = body[pos + 1], body[pos + 2]
+            end = pos + 3 + count
+            if end <= len(body) and offset + count <= DISPLAY_RAM_SIZE:
+                records.append(("ram", offset, body[pos + 3:end]))
+                pos = end
+                continue
+        elif kind == NUMBER and pos + 7 <= len(body):
+            line, fmt = body[pos + 1], body[pos + 2]
+            if line < SEGMENT_LINES and (fmt & NUMBER_DECIMAL_MASK) < SEGMENT_COLS:
+                (value,) = struct.unpack("<i", body[pos + 3:pos + 7])
+                records.append(("num", line, value, fmt & NUMBER_DECIMAL_MASK, bool(fmt & NUMBER_COMMA)))
+                pos += 7
+                continue
+        elif kind == INDICATOR and pos + 2 <= len(body):
+            records.append(("ind", body[pos + 1]))
+            pos += 2
+            continue
+        elif kind == CHARACTER_CELLS and pos + 4 <= len(body):
+            line, column, count = body[pos + 1], body[pos + 2], body[pos + 3]
+            end = pos + 4 + count
+            if end <= len(body) and line < CHARACTER_LINES and column + count <= CHARACTER_COLS:
+                records.append(("chr", line, column, body[pos + 4:end]))
+                pos = end
+                continue
+        raise ValueError("malformed record at %d" % pos)
+    return records
+
+
+def parse_record(spec):
+    fields = spec.split(":")
+    kind = fields[0]
+    if kind == "ram":
+        return ram_patch(int(fields[1], 0), bytes.fromhex(fields[2]))
+    if kind == "num":
+        decimals = int(fields[3]) if len(fields) > 3 else 0
+        return number(int(fields[1]), int(fields[2]), decimals, len(fields) > 4 and fields[4] == "comma")
+    if kind == "ind":
+        return indicator(int(fields[1], 0))
+    if kind == "chr":
+        return character_cells(int(fields[1]), int(fields[2]), ":".join(fields[3:]).encode("ascii"))
+    raise ValueError("unknown record " + spec)
+
+
+def main():
+    if len(sys.argv) < 3:
+        sys.exit(__doc__)
+    if sys.argv[1] == "encode":
+        print(encode([parse_record(spec) for spec in sys.argv[2:]]).hex(" "))
+    elif sys.argv[1] == "decode":
+        for record in decode(bytes.fromhex("".join(sys.argv[2:]))):
+            print(record)
+    else:
+        sys.exit(__doc__)
+
+
+if __name__ == "__main__":
+    main()
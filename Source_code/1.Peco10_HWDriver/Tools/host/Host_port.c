@@ -0,0 +1,250 @@
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+#include <pthread.h>
+#include <time.h>
+#include "main.h"
+#include "Timebase.h"
+#include "Keypad.h"
+/*==================================================================================================
+*                                  LOCAL VARIABLE DECLARATIONS
+==================================================================================================*/
+/* Held while a thread has "interrupts" masked */
+static pthread_mutex_t HostIrqLock = PTHREAD_MUTEX_INITIALIZER;
+/* PRIMASK of the calling thread */
+static __thread uint32_t HostPrimask = 0U;
+
+/* Pin levels and the board behind them, changed by one pin write or read at a time */
+static pthread_mutex_t HostPinLock = PTHREAD_MUTEX_INITIALIZER;
+/* Shift registers and output latches of the chain, stage 0 next to the MCU */
+static uint8_t HostShift[IC_74HC595_STAGES];
+static uint8_t HostOutput[IC_74HC595_STAGES];
+/* SHCP rising edges since the last STCP rising edge */
+static uint32_t HostShiftCount = 0U;
+static uint32_t HostLatchCount = 0U;
+static uint32_t HostBadLatchCount = 0U;
+static uint16_t HostKeys = 0U;
+static uint8_t HostSwitch = 0U;
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+GPIO_TypeDef HostGpioA;
+GPIO_TypeDef HostGpioB;
+/*==================================================================================================
+*                                         LOCAL FUNCTIONS
+==================================================================================================*/
+/* Each stage passes its Q7 on to the next one */
+static void Host_Shift_Clock(void)
+{
+    uint8_t Stage;
+
+    for(Stage = IC_74HC595_STAGES - 1U; Stage > 0U; Stage--)
+    {
+        HostShift[Stage] = (uint8_t)((HostShift[Stage] << 1) | (HostShift[Stage - 1U] >> 7));
+    }
+    HostShift[0] = (uint8_t)((HostShift[0] << 1) | (((DS_PORT->IDR & DS_PIN) != 0U) ? 1U : 0U));
+    HostShiftCount++;
+}
+
+static void Host_Latch_Clock(void)
+{
+    uint8_t Stage;
+
+    for(Stage = 0U; Stage < IC_74HC595_STAGES; Stage++)
+    {
+        HostOutput[Stage] = HostShift[Stage];
+    }
+    /* A shift of another context in between leaves a count of its own */
+    if(HostShiftCount != (8U * IC_74HC595_STAGES))
+    {
+        HostBadLatchCount++;
+    }
+    HostShiftCount = 0U;
+    HostLatchCount++;
+}
+
+/* 74LS151 input picked by A, B, C: keypad rows on D0-D3, address switch on D4-D7 */
+static GPIO_PinState Host_Mux_Input(void)
+{
+    uint8_t Select = (uint8_t)((((A_PORT->IDR & A_PIN) != 0U) ? 1U : 0U) |
+                               (((B_PORT->IDR & B_PIN) != 0U) ? 2U : 0U) |
+                               (((C_PORT->IDR & C_PIN) != 0U) ? 4U : 0U));
+    uint8_t Col;
+
+    if(Select >= NUM_ROWS)
+    {
+        return ((HostSwitch & (1U << (Select - NUM_ROWS))) != 0U) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+    }
+    /* A key held down pulls its row to the level of its column output */
+    for(Col = 0U; Col < NUM_COLS; Col++)
+    {
+        if(((HostKeys & KEYPAD_KEY_BIT(Select, Col)) != 0U) && ((HostOutput[KEYPAD] & (1U << Col)) == 0U))
+        {
+            return GPIO_PIN_RESET;
+        }
+    }
+    return GPIO_PIN_SET;
+}
+/*==================================================================================================
+*                                         GLOBAL FUNCTIONS
+==================================================================================================*/
+uint32_t __get_PRIMASK(void)
+{
+    return HostPrimask;
+}
+
+void __disable_irq(void)
+{
+    if(HostPrimask == 0U)
+    {
+        (void)pthread_mutex_lock(&HostIrqLock);
+        HostPrimask = 1U;
+    }
+}
+
+void __enable_irq(void)
+{
+    if(HostPrimask != 0U)
+    {
+        HostPrimask = 0U;
+        (void)pthread_mutex_unlock(&HostIrqLock);
+    }
+}
+
+void __set_PRIMASK(uint32_t Primask)
+{
+    if(Primask != 0U)
+    {
+        __disable_irq();
+    }
+    else
+    {
+        __enable_irq();
+    }
+}
+
+/* Timebase on CLOCK_MONOTONIC, same 1 us wrapping counter as TIM2 */
+uint32_t Timebase_Now(void)
+{
+    struct timespec Now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &Now);
+    return (uint32_t)(((uint64_t)Now.tv_sec * 1000000U) + ((uint64_t)Now.tv_nsec / 1000U));
+}
+
+uint32_t Timebase_Deadline_After(uint32_t us)
+{
+    return Timebase_Now() + us;
+}
+
+uint8_t Timebase_Expired(uint32_t Deadline)
+{
+    return (uint8_t)((int32_t)(Timebase_Now() - Deadline) >= 0);
+}
+
+uint32_t Timebase_Elapsed(uint32_t Start)
+{
+    return Timebase_Now() - Start;
+}
+
+void Timebase_Wait_Until(uint32_t Deadline)
+{
+    uint32_t Remaining = Deadline - Timebase_Now();
+
+    if((int32_t)Remaining > 0)
+    {
+        Os_Sleep_Us(Remaining);
+    }
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    uint8_t Rising;
+
+    (void)pthread_mutex_lock(&HostPinLock);
+    Rising = (uint8_t)(((GPIOx->IDR & GPIO_Pin) == 0U) && (PinState != GPIO_PIN_RESET));
+    if(PinState != GPIO_PIN_RESET)
+    {
+        GPIOx->IDR |= GPIO_Pin;
+    }
+    else
+    {
+        GPIOx->IDR &= ~(uint32_t)GPIO_Pin;
+    }
+    if(Rising != 0U)
+    {
+        if((GPIOx == SHCP_PORT) && (GPIO_Pin == SHCP_PIN))
+        {
+            Host_Shift_Clock();
+        }
+        else if((GPIOx == STCP_PORT) && (GPIO_Pin == STCP_PIN))
+        {
+            Host_Latch_Clock();
+        }
+    }
+    (void)pthread_mutex_unlock(&HostPinLock);
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin)
+{
+    GPIO_PinState State;
+
+    (void)pthread_mutex_lock(&HostPinLock);
+    if((GPIOx == Y_PORT) && (GPIO_Pin == Y_PIN))
+    {
+        State = Host_Mux_Input();
+    }
+    else
+    {
+        State = ((GPIOx->IDR & GPIO_Pin) != 0U) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+    }
+    (void)pthread_mutex_unlock(&HostPinLock);
+    return State;
+}
+
+void Host_Set_Keys(uint16_t Keys)
+{
+    (void)pthread_mutex_lock(&HostPinLock);
+    HostKeys = Keys;
+    (void)pthread_mutex_unlock(&HostPinLock);
+}
+
+void Host_Set_Switch(uint8_t Value)
+{
+    (void)pthread_mutex_lock(&HostPinLock);
+    HostSwitch = Value;
+    (void)pthread_mutex_unlock(&HostPinLock);
+}
+
+uint8_t Host_Get_Output(uint8_t Stage)
+{
+    uint8_t Output;
+
+    (void)pthread_mutex_lock(&HostPinLock);
+    Output = HostOutput[Stage];
+    (void)pthread_mutex_unlock(&HostPinLock);
+    return Output;
+}
+
+uint32_t Host_Get_Latch_Count(void)
+{
+    uint32_t Count;
+
+    (void)pthread_mutex_lock(&HostPinLock);
+    Count = HostLatchCount;
+    (void)pthread_mutex_unlock(&HostPinLock);
+    return Count;
+}
+
+uint32_t Host_Get_Bad_Latch_Count(void)
+{
+    uint32_t Count;
+
+    (void)pthread_mutex_lock(&HostPinLock);
+    Count = HostBadLatchCount;
+    (void)pthread_mutex_unlock(&HostPinLock);
+    return Count;
+}
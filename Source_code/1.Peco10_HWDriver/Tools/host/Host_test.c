@@ -0,0 +1,301 @@
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/* Runs Os_port.c (OS_PORT_POSIX), Event_bus.c, Standard.c and Keypad.c as POSIX threads, a thread
+ * stands in for the interrupts which publish on the target, another one writes the character LCD
+ * stage of the 74HC595 chain while the keypad is scanned. Exit status 0 when every check passes */
+#include <pthread.h>
+#include <stdio.h>
+#include "Os_port.h"
+#include "Event_bus.h"
+#include "Keypad.h"
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+/* Events published by the interrupt thread */
+#define HOST_BURST_EVENTS                       (20000U)
+/* Longest wait of a check, a wake which comes later is a failure */
+#define HOST_TIMEOUT_US                         (200000U)
+/* Keypad scans done while the LCD thread shifts the chain */
+#define HOST_KEYPAD_SCANS                       (2000U)
+/* Key held down during the scans, F2 */
+#define HOST_KEY                                KEYPAD_KEY_BIT(1U, 3U)
+#define HOST_SWITCH                             (0x0AU)
+
+#define HOST_CHECK(__COND__)                    Host_Check((uint8_t)((__COND__) ? 1U : 0U), #__COND__, __LINE__)
+/*==================================================================================================
+*                                  LOCAL VARIABLE DECLARATIONS
+==================================================================================================*/
+static uint32_t HostFailures = 0U;
+
+static Os_Mutex_Type HostMutex;
+static volatile uint8_t HostMutexTaken = 0U;
+static Os_Semaphore_Type HostSemaphore;
+
+/* Delivered by Event_Dispatch */
+static uint32_t HostKeyCount = 0U;
+static uint32_t HostKeyNext = 0U;
+static uint32_t HostKeyOutOfOrder = 0U;
+static uint32_t HostReceivedCount = 0U;
+/* Set by the interrupt thread after its last publish */
+static volatile uint8_t HostBurstDone = 0U;
+/* Set by the main thread once its scans are done, last byte sent by the LCD thread */
+static volatile uint8_t HostScansDone = 0U;
+static uint8_t HostLcdLast = 0U;
+/* Sends of the LCD thread not latched on return, only an interrupt may get E_NOT_OK */
+static uint32_t HostLcdNotLatched = 0U;
+/*==================================================================================================
+*                                         LOCAL FUNCTIONS
+==================================================================================================*/
+static void Host_Check(uint8_t Passed, const char* pText, int Line)
+{
+    if(Passed == 0U)
+    {
+        HostFailures++;
+        printf("FAIL line %d: %s\n", Line, pText);
+    }
+}
+
+static void Host_On_Key(const Event_Type* pEvent)
+{
+    /* Queued events keep their order, a dropped one leaves a gap and nothing else */
+    if(pEvent->Data < HostKeyNext)
+    {
+        HostKeyOutOfOrder++;
+    }
+    HostKeyNext = pEvent->Data + 1U;
+    HostKeyCount++;
+}
+
+static void Host_On_Received(const Event_Type* pEvent)
+{
+    (void)pEvent;
+    HostReceivedCount++;
+}
+
+static void* Host_Mutex_Thread(void* pArgument)
+{
+    (void)pArgument;
+    Os_Mutex_Lock(&HostMutex);
+    HostMutexTaken = 1U;
+    Os_Mutex_Unlock(&HostMutex);
+    return NULL;
+}
+
+static void* Host_Give_Thread(void* pArgument)
+{
+    (void)pArgument;
+    Os_Sleep_Us(20000U);
+    Os_Semaphore_Give(&HostSemaphore);
+    return NULL;
+}
+
+static void* Host_Interrupt_Thread(void* pArgument)
+{
+    uint32_t i;
+
+    (void)pArgument;
+    for(i = 0U; i < HOST_BURST_EVENTS; i++)
+    {
+        (void)Event_Publish(EVENT_KEY_PRESSED, i);
+        if((i % 64U) == 0U)
+        {
+            (void)Event_Publish(EVENT_SERIAL_RECEIVED, 0U);
+        }
+    }
+    __disable_irq();
+    HostBurstDone = 1U;
+    __enable_irq();
+    return NULL;
+}
+
+static void* Host_Lcd_Thread(void* pArgument)
+{
+    uint8_t Data = 0U;
+
+    (void)pArgument;
+    do
+    {
+        Data++;
+        if(IC_74hc595_Transaction(LCD_CHARACTER, 0xFFU, Data) != E_OK)
+        {
+            HostLcdNotLatched++;
+        }
+    }while(HostScansDone == 0U);
+    HostLcdLast = Data;
+    return NULL;
+}
+
+static void Host_Test_Mutex(void)
+{
+    pthread_t Thread;
+
+    Os_Mutex_Init(&HostMutex);
+    /* Recursive: the owner locks it again */
+    Os_Mutex_Lock(&HostMutex);
+    Os_Mutex_Lock(&HostMutex);
+    (void)pthread_create(&Thread, NULL, Host_Mutex_Thread, NULL);
+    Os_Sleep_Us(20000U);
+    Os_Mutex_Unlock(&HostMutex);
+    Os_Sleep_Us(20000U);
+    HOST_CHECK(HostMutexTaken == 0U);
+    Os_Mutex_Unlock(&HostMutex);
+    (void)pthread_join(Thread, NULL);
+    HOST_CHECK(HostMutexTaken == 1U);
+}
+
+static void Host_Test_Semaphore(void)
+{
+    pthread_t Thread;
+    uint32_t Start;
+
+    Os_Semaphore_Init(&HostSemaphore);
+    Start = Timebase_Now();
+    HOST_CHECK(Os_Semaphore_Take(&HostSemaphore, 10000U) == 0U);
+    HOST_CHECK(Timebase_Elapsed(Start) >= 10000U);
+
+    /* Binary: two gives before a take count as one */
+    Os_Semaphore_Give(&HostSemaphore);
+    Os_Semaphore_Give(&HostSemaphore);
+    HOST_CHECK(Os_Semaphore_Take(&HostSemaphore, 0U) == 1U);
+    HOST_CHECK(Os_Semaphore_Take(&HostSemaphore, 1000U) == 0U);
+
+    /* A give from another thread ends a long take early */
+    (void)pthread_create(&Thread, NULL, Host_Give_Thread, NULL);
+    Start = Timebase_Now();
+    HOST_CHECK(Os_Semaphore_Take(&HostSemaphore, OS_WAIT_FOREVER) == 1U);
+    HOST_CHECK(Timebase_Elapsed(Start) < HOST_TIMEOUT_US);
+    (void)pthread_join(Thread, NULL);
+}
+
+static void Host_Test_Level_Events(void)
+{
+    uint32_t i;
+    uint32_t Dropped = Event_Get_Dropped_Count();
+
+    HostKeyCount = 0U;
+    HostKeyNext = 0U;
+    HostReceivedCount = 0U;
+    /* Full queue: a queued event is dropped, a level event is kept and merged */
+    for(i = 0U; i < EVENT_QUEUE_SIZE; i++)
+    {
+        HOST_CHECK(Event_Publish(EVENT_KEY_PRESSED, i) == E_OK);
+    }
+    HOST_CHECK(Event_Publish(EVENT_KEY_PRESSED, EVENT_QUEUE_SIZE) == E_NOT_OK);
+    HOST_CHECK(Event_Publish(EVENT_SERIAL_RECEIVED, 0U) == E_OK);
+    HOST_CHECK(Event_Publish(EVENT_SERIAL_RECEIVED, 0U) == E_OK);
+    HOST_CHECK(Event_Dispatch() == (EVENT_QUEUE_SIZE + 1U));
+    HOST_CHECK(HostKeyCount == EVENT_QUEUE_SIZE);
+    HOST_CHECK(HostReceivedCount == 1U);
+    HOST_CHECK(Event_Get_Dropped_Count() == (Dropped + 1U));
+}
+
+static void Host_Test_Wake(void)
+{
+    uint32_t Start;
+
+    /* A give left over from the publishes above may end the first wait */
+    Event_Wait_Until(Timebase_Deadline_After(1000U));
+    HostReceivedCount = 0U;
+    Start = Timebase_Now();
+    Event_Wait_Until(Timebase_Deadline_After(10000U));
+    HOST_CHECK(Timebase_Elapsed(Start) >= 9000U);
+
+    /* Pending event: no wait at all */
+    HOST_CHECK(Event_Publish(EVENT_SERIAL_RECEIVED, 0U) == E_OK);
+    Start = Timebase_Now();
+    Event_Wait_Until(Timebase_Deadline_After(HOST_TIMEOUT_US));
+    HOST_CHECK(Timebase_Elapsed(Start) < (HOST_TIMEOUT_US / 2U));
+    (void)Event_Dispatch();
+    HOST_CHECK(HostReceivedCount == 1U);
+}
+
+static void Host_Test_Burst(void)
+{
+    pthread_t Thread;
+    uint32_t Dropped = Event_Get_Dropped_Count();
+    uint32_t Deadline;
+    uint8_t Done = 0U;
+
+    HostKeyCount = 0U;
+    HostKeyNext = 0U;
+    HostKeyOutOfOrder = 0U;
+    HostReceivedCount = 0U;
+    (void)pthread_create(&Thread, NULL, Host_Interrupt_Thread, NULL);
+    Deadline = Timebase_Deadline_After(10U * HOST_TIMEOUT_US);
+    /* The main loop: sleep until something is published, dispatch it */
+    while((Done == 0U) && (Timebase_Expired(Deadline) == 0U))
+    {
+        Event_Wait_Until(Timebase_Deadline_After(1000U));
+        (void)Event_Dispatch();
+        __disable_irq();
+        Done = HostBurstDone;
+        __enable_irq();
+    }
+    (void)pthread_join(Thread, NULL);
+    (void)Event_Dispatch();
+    printf("burst: %u delivered, %u dropped, %u level wakes\n", (unsigned int)HostKeyCount,
+           (unsigned int)(Event_Get_Dropped_Count() - Dropped), (unsigned int)HostReceivedCount);
+    HOST_CHECK((HostKeyCount + (Event_Get_Dropped_Count() - Dropped)) == HOST_BURST_EVENTS);
+    HOST_CHECK(HostKeyOutOfOrder == 0U);
+    HOST_CHECK(HostReceivedCount >= 1U);
+}
+static void Host_Test_Chain(void)
+{
+    pthread_t Thread;
+    uint32_t Latches;
+    uint32_t i;
+    uint32_t Wrong = 0U;
+    uint8_t Key[3];
+
+    Host_Set_Keys(HOST_KEY);
+    Host_Set_Switch(HOST_SWITCH);
+    Latches = Host_Get_Latch_Count();
+    (void)pthread_create(&Thread, NULL, Host_Lcd_Thread, NULL);
+    /* The LCD shifts keep the keypad stage, a scan sees its own column outputs only */
+    for(i = 0U; i < HOST_KEYPAD_SCANS; i++)
+    {
+        if(Keypad_Scan_Matrix() != HOST_KEY)
+        {
+            Wrong++;
+        }
+    }
+    HOST_CHECK(Keypad_Scan(Key) == KEYPAD_PUSHED);
+    HOST_CHECK(strcmp((char*)Key, "F2") == 0);
+    HOST_CHECK(Config_Switch_Get_Value() == HOST_SWITCH);
+    HostScansDone = 1U;
+    (void)pthread_join(Thread, NULL);
+    printf("chain: %u latch cycles, %u wrong scans\n", (unsigned int)(Host_Get_Latch_Count() - Latches),
+           (unsigned int)Wrong);
+    HOST_CHECK(Wrong == 0U);
+    HOST_CHECK(HostLcdNotLatched == 0U);
+    HOST_CHECK(Host_Get_Bad_Latch_Count() == 0U);
+    HOST_CHECK(Host_Get_Output(LCD_CHARACTER) == HostLcdLast);
+    HOST_CHECK(Host_Get_Output(KEYPAD) == DUMMY_DATA);
+
+    Host_Set_Keys(0U);
+    HOST_CHECK(Keypad_Scan_Matrix() == 0U);
+}
+/*==================================================================================================
+*                                         GLOBAL FUNCTIONS
+==================================================================================================*/
+int main(void)
+{
+    Standard_Init();
+    Event_Init();
+    (void)Event_Subscribe(EVENT_KEY_PRESSED, Host_On_Key);
+    (void)Event_Subscribe(EVENT_SERIAL_RECEIVED, Host_On_Received);
+
+    Host_Test_Mutex();
+    Host_Test_Semaphore();
+    Host_Test_Level_Events();
+    Host_Test_Wake();
+    Host_Test_Burst();
+    Host_Test_Chain();
+
+    printf("%s\n", (HostFailures == 0U) ? "PASS" : "FAIL");
+    return (HostFailures == 0U) ? 0 : 1;
+}
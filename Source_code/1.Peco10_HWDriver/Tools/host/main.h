@@ -0,0 +1,92 @@
+#ifndef __MAIN_H
+#define __MAIN_H
+
+/*==================================================================================================
+*                                        INCLUDE FILES
+* 1) system and project includes
+* 2) needed interfaces from external units
+* 3) internal and external interfaces from this unit
+==================================================================================================*/
+/* Host stand-in for Core/Inc/main.h: found first on the include path of Tools/host/Makefile,
+ * it gives the drivers the few HAL and CMSIS-Core names they use so the OS_PORT_POSIX build of
+ * Os_port.c, Event_bus.c, Standard.c and Keypad.c compiles and runs as POSIX threads. The pins
+ * of the 74HC595 chain and the 74LS151 are emulated by Host_port.c */
+#include <stdint.h>
+#include <stddef.h>
+/*==================================================================================================
+                                       DEFINES AND MACROS
+==================================================================================================*/
+#define PECO10_LL_BUILD                         0U
+
+/* Ports of the pins of Standard.h, told apart by address only */
+#define GPIOA                                   (&HostGpioA)
+#define GPIOB                                   (&HostGpioB)
+#define GPIO_PIN_3                              ((uint16_t)0x0008U)
+#define GPIO_PIN_4                              ((uint16_t)0x0010U)
+#define GPIO_PIN_5                              ((uint16_t)0x0020U)
+#define GPIO_PIN_6                              ((uint16_t)0x0040U)
+#define GPIO_PIN_7                              ((uint16_t)0x0080U)
+#define GPIO_PIN_11                             ((uint16_t)0x0800U)
+#define GPIO_PIN_12                             ((uint16_t)0x1000U)
+
+/* IC_74HC595_TW_WAIT: the emulated pins have no timing */
+#define __NOP()                                 ((void)0)
+/*==================================================================================================
+*                                  STRUCTURES AND OTHER TYPEDEFS
+==================================================================================================*/
+typedef struct
+{
+    uint32_t IDR;
+} GPIO_TypeDef;
+
+/* Handles declared by Timebase.h */
+typedef struct
+{
+    void* Instance;
+} TIM_HandleTypeDef;
+
+typedef struct
+{
+    void* Instance;
+} SPI_HandleTypeDef;
+
+typedef enum
+{
+    GPIO_PIN_RESET = 0U,
+    GPIO_PIN_SET
+} GPIO_PinState;
+/*==================================================================================================
+*                                  GLOBAL VARIABLE DECLARATIONS
+==================================================================================================*/
+extern GPIO_TypeDef HostGpioA;
+extern GPIO_TypeDef HostGpioB;
+/*==================================================================================================
+*                                       FUNCTION PROTOTYPES
+==================================================================================================*/
+/**
+ * @brief  Interrupt masking of the drivers: one process wide lock, PRIMASK is per thread
+ *         (Host_port.c). A thread playing an interrupt publishes with it held like the core would
+ */
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t Primask);
+void __disable_irq(void);
+void __enable_irq(void);
+
+/**
+ * @brief  Pins of the 74HC595 chain and the 74LS151 mux (Host_port.c): a write may clock the chain,
+ *         the read of Y gives the mux input picked by the select lines
+ */
+void HAL_GPIO_WritePin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin);
+
+/**
+ * @brief  Board seen by the emulated pins, for Host_test.c: the keys held down (KEYPAD_KEY_BIT),
+ *         the address switch, the latched chain and the latch cycles without 8 shifts per stage
+ */
+void Host_Set_Keys(uint16_t Keys);
+void Host_Set_Switch(uint8_t Value);
+uint8_t Host_Get_Output(uint8_t Stage);
+uint32_t Host_Get_Latch_Count(void);
+uint32_t Host_Get_Bad_Latch_Count(void);
+
+#endif /* __MAIN_H */
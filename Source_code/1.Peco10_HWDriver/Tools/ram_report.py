@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+"""Static RAM per module from the armlink map file (MDK-ARM/<target>/*.map).
+
+Reads the "Image component sizes" tables (RW + ZI data of each object and library member),
+splits the STACK and HEAP areas of the startup file out of its ZI data, and compares the
+total with the size of the RAM execution region. Stack_monitor gives the run time side:
+how much of the STACK area is really used.
+
+Usage: ram_report.py <map> [--symbols N] [--min-free BYTES]
+
+  --symbols N         also list the N largest variables in RAM
+  --min-free BYTES    exit with status 1 when less RAM is left, e.g. as a uVision
+                      "After Build" user command so a build that eats the margin fails
+"""
+import re
+import sys
+
+SIZES_HEADER = re.compile(r"^\s*Code \(inc\. data\)\s+RO Data\s+RW Data\s+ZI Data\s+Debug\s*(.*?)\s*$")
+SIZES_ROW = re.compile(r"^\s*(\d+)\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)\s+(\S+)\s*$")
+RAM_REGION = re.compile(r"Execution Region (\S+) \(Exec base: (0x[0-9a-fA-F]+),.*Size: (0x[0-9a-fA-F]+), Max: (0x[0-9a-fA-F]+)")
+SYMBOL = re.compile(r"^\s+(\S+)\s+(0x[0-9a-fA-F]+)\s+(Data|Section)\s+(\d+)\s+(\S+)\((\S+)\)\s*$")
+TOTAL_RW = re.compile(r"Total RW\s+Size \(RW Data \+ ZI Data\)\s+(\d+)")
+
+# Image component sizes columns
+COL_RW = 3
+COL_ZI = 4
+COL_NAME = 6
+
+# Areas of startup_stm32g031xx.s, reported on their own lines
+STARTUP_AREAS = ("STACK", "HEAP")
+RAM_BASE = 0x20000000
+
+
+def parse(path):
+    modules = {}
+    areas = {}
+    symbols = {}
+    region = None
+    total_rw = None
+    # Rows of the table being read: "Object Name", "Library Member Name", others are totals
+    table = None
+    with open(path, errors="replace") as f:
+        for line in f:
+            header = SIZES_HEADER.match(line)
+            if header:
+                table = header.group(1)
+                continue
+            row = SIZES_ROW.match(line)
+            if row and table in ("Object Name", "Library Member Name"):
+                name = row.group(COL_NAME + 1)
+                rw = int(row.group(COL_RW + 1))
+                zi = int(row.group(COL_ZI + 1))
+                key = "C library" if table == "Library Member Name" else name
+                old = modules.get(key, (0, 0))
+                modules[key] = (old[0] + rw, old[1] + zi)
+                continue
+            match = RAM_REGION.search(line)
+            if match and (int(match.group(2), 16) & 0xFF000000) == RAM_BASE:
+                region = (match.group(1), int(match.group(3), 16), int(match.group(4), 16))
+                continue
+            match = SYMBOL.match(line)
+            if match and (int(match.group(2), 16) & 0xFF000000) == RAM_BASE:
+                name, kind, size, obj, section = (match.group(1), match.group(3), int(match.group(4)),
+                                                  match.group(5), match.group(6))
+                if kind == "Section" and section in STARTUP_AREAS:
+                    areas[section] = (obj, size)
+                elif kind == "Data" and size > 0:
+                    symbols[(name, obj)] = size
+                continue
+            match = TOTAL_RW.search(line)
+            if match:
+                total_rw = int(match.group(1))
+    # Stack and heap are ZI data of the startup object, show them apart
+    for obj, size in areas.values():
+        if obj in modules:
+            rw, zi = modules[obj]
+            modules[obj] = (rw, max(zi - size, 0))
+    return modules, areas, symbols, region, total_rw
+
+
+def main(argv):
+    if len(argv) < 2:
+        print(__doc__)
+        return 2
+    path = argv[1]
+    top = 0
+    min_free = None
+    i = 2
+    while i < len(argv):
+        if argv[i] == "--symbols" and i + 1 < len(argv):
+            top = int(argv[i + 1], 0)
+            i += 2
+        elif argv[i] == "--min-free" and i + 1 < len(argv):
+            min_free = int(argv[i + 1], 0)
+            i += 2
+        else:
+            print(__doc__)
+            return 2
+
+    modules, areas, symbols, region, total_rw = parse(path)
+    if not modules:
+        print("no Image component sizes table in %s" % path)
+        return 2
+    ram = region[2] if region else None
+    used = total_rw if total_rw is not None else sum(rw + zi for rw, zi in modules.values()) + \
+        sum(size for _, size in areas.values())
+
+    def percent(value):
+        return "%5.1f%%" % (100.0 * value / ram) if ram else ""
+
+    print("%-28s %7s %7s %7s %7s" % ("Module", "RW", "ZI", "RAM", ""))
+    for name, (rw, zi) in sorted(modules.items(), key=lambda item: -(item[1][0] + item[1][1])):
+        if rw + zi:
+            print("%-28s %7d %7d %7d %7s" % (name, rw, zi, rw + zi, percent(rw + zi)))
+    for area in STARTUP_AREAS:
+        if area in areas:
+            size = areas[area][1]
+            print("%-28s %7s %7d %7d %7s" % (area.lower() + " (startup)", "", size, size, percent(size)))
+    print("-" * 62)
+    print("%-28s %7s %7s %7d %7s" % ("Total", "", "", used, percent(used)))
+    if ram:
+        print("%-28s %7s %7s %7d %7s" % ("Free (" + region[0] + ")", "", "", ram - used, percent(ram - used)))
+
+    if top:
+        print("")
+        print("%-36s %-24s %7s" % ("Variable", "Module", "Bytes"))
+        for (name, obj), size in sorted(symbols.items(), key=lambda item: -item[1])[:top]:
+            print("%-36s %-24s %7d" % (name, obj, size))
+
+    if min_free is not None and ram and (ram - used) < min_free:
+        print("RAM margin below %d bytes" % min_free)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+"""Bus master stand-in for the Peco10 serial slave (see Include/Serial_slave.h).
+
+Sends one frame per command, followed by an idle gap so the slave sees the frame end.
+
+  serial_master.py <tty|--pty> <address> seg <line> <text>
+  serial_master.py <tty|--pty> <address> ind <byte> [<blink mask>]
+  serial_master.py <tty|--pty> <address> chr <line> <offset> <text>
+  serial_master.py <tty|--pty> <address> clr
+  serial_master.py <tty|--pty> <address> delta <record> [<record> ...]
+  serial_master.py <tty|--pty> <address> pwr <save|on>
+  serial_master.py <tty|--pty> <address> time <YYYYMMDD> <HHMMSS>
+
+delta records use the display_delta.py syntax (ram:, num:, ind:, chr:) and go out as one
+CRC protected batch. A slave in standby wakes on the first frame and drops it, so send a
+command twice after a long pause.
+
+<tty> is a real port (USB/RS-485 adapter) or one end of a socat pty pair. With --pty a
+pseudo terminal is opened, its slave path printed, and the frame bytes echoed as hex so
+the encoding can be checked on Linux without hardware. Address 255 is broadcast.
+"""
+import os
+import struct
+import sys
+import termios
+import time
+
+import display_delta
+
+FRAME_START = 0xA5
+CMD_SEGMENT_TEXT = 0x01
+CMD_SEGMENT_INDICATOR = 0x02
+CMD_CHARACTER_TEXT = 0x03
+CMD_CHARACTER_CLEAR = 0x04
+CMD_DISPLAY_DELTA = 0x05
+CMD_SEGMENT_POWER = 0x06
+SEGMENT_POWER = {"on": 0x00, "save": 0x01}
+CMD_CALENDAR = 0x07
+# SERIAL_RX_BUFFER_SIZE: a whole frame must fit in the slave receive ring
+RX_BUFFER_SIZE = 256
+FRAME_OVERHEAD = 5
+BAUDRATE = termios.B115200
+
+
+def frame(address, command, payload=b""):
+    body = bytes([address & 0xFF, command, len(payload)]) + bytes(payload)
+    checksum = (-sum(body)) & 0xFF
+    return bytes([FRAME_START]) + body + bytes([checksum])
+
+
+def build(address, args):
+    kind = args[0]
+    if kind == "seg":
+        return frame(address, CMD_SEGMENT_TEXT, bytes([int(args[1])]) + args[2].encode("ascii"))
+    if kind == "ind":
+        return frame(address, CMD_SEGMENT_INDICATOR, bytes([int(value, 0) for value in args[1:3]]))
+    if kind == "chr":
+        return frame(address, CMD_CHARACTER_TEXT,
+                     bytes([int(args[1]), int(args[2])]) + args[3].encode("ascii"))
+    if kind == "clr":
+        return frame(address, CMD_CHARACTER_CLEAR)
+    if kind == "delta":
+        batch = display_delta.encode([display_delta.parse_record(spec) for spec in args[1:]])
+        if len(batch) > RX_BUFFER_SIZE - FRAME_OVERHEAD:
+            sys.exit("delta batch longer than one frame")
+        return frame(address, CMD_DISPLAY_DELTA, batch)
+    if kind == "pwr" and len(args) == 2 and args[1] in SEGMENT_POWER:
+        return frame(address, CMD_SEGMENT_POWER, bytes([SEGMENT_POWER[args[1]]]))
+    if kind == "time" and len(args) == 3:
+        # Digits go out as BCD: the decimal text is read as hex
+        return frame(address, CMD_CALENDAR, struct.pack("<II", int(args[1], 16), int(args[2], 16)))
+    sys.exit(__doc__)
+
+
+def open_port(path):
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+    attr = termios.tcgetattr(fd)
+    attr[0] = 0                                   # iflag
+    attr[1] = 0                                   # oflag
+    attr[2] = termios.CS8 | termios.CREAD | termios.CLOCAL
+    attr[3] = 0                                   # lflag
+    attr[4] = attr[5] = BAUDRATE
+    termios.tcsetattr(fd, termios.TCSANOW, attr)
+    return fd
+
+
+def send(fd, data, is_tty=True):
+    os.write(fd, data)
+    if is_tty:
+        termios.tcdrain(fd)
+    # Idle line: leave well over one character time before the next frame
+    time.sleep(0.002)
+
+
+def main():
+    if len(sys.argv) < 4:
+        sys.exit(__doc__)
+    data = build(int(sys.argv[2], 0), sys.argv[3:])
+    if sys.argv[1] == "--pty":
+        master, slave = os.openpty()
+        print("pty slave:", os.ttyname(slave))
+        send(master, data, is_tty=False)
+        print("frame:", data.hex(" "))
+        return
+    fd = open_port(sys.argv[1])
+    send(fd, data)
+    os.close(fd)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""Export a Peco10 trace dump as Chrome trace-event JSON (chrome://tracing, Perfetto).
+
+Spans (enter/exit) become B/E events and point events (595 latch, SPI bytes, SCE level,
+keypad row samples, HD44780 commands) become instant events carrying their data word.
+Every driver gets its own track so one superloop pass shows how the segment LCD,
+the keypad scan and the character LCD interleave and where the core waits.
+
+Usage: trace_chrome.py <dump> <out.json>
+"""
+import json
+import sys
+
+from trace_table import EVENT_ENTER, EVENT_EXIT, load
+
+# Track (tid) per trace id, ids missing here go to track 1
+TRACKS = {
+    "IC_74hc595": (2, "74HC595 chain"),
+    "IC_74hc595_Transaction": (2, "74HC595 chain"),
+    "595_Latch": (2, "74HC595 chain"),
+    "Lcd_Frame_Transfer": (3, "Segment LCD / SPI1"),
+    "Lcd_Segment_Display_App": (3, "Segment LCD / SPI1"),
+    "SPI_Transfer": (3, "Segment LCD / SPI1"),
+    "LCD_SCE": (3, "Segment LCD / SPI1"),
+    "Keypad_Scan": (4, "Keypad / switch"),
+    "Config_Switch_Get_Value": (4, "Keypad / switch"),
+    "Keypad_Row": (4, "Keypad / switch"),
+    "lcd_enable": (5, "Character LCD"),
+    "Lcd_Put_Char": (5, "Character LCD"),
+    "HD44780_Command": (5, "Character LCD"),
+    "Busy_Wait": (6, "Busy waits"),
+}
+
+
+def decode(name, data):
+    if name == "Keypad_Row":
+        return {"col": data >> 8, "row": (data >> 4) & 0xF, "level": data & 1}
+    if name == "SPI_Transfer":
+        return {"first": "0x%02X" % (data >> 8), "length": data & 0xFF}
+    if name == "Event":
+        return {"id": data >> 8, "data": "0x%02X" % (data & 0xFF)}
+    if name in ("595_Latch", "HD44780_Command"):
+        return {"value": "0x%02X" % data}
+    return {"data": data}
+
+
+def export(records, names):
+    events = []
+    seen = {}
+    stamp = 0
+    last = records[0][0] if records else 0
+    for raw, ident, event, data in records:
+        # Unwrap the 32 bits TIM2 counter into a monotonic timeline
+        stamp += (raw - last) & 0xFFFFFFFF
+        last = raw
+        name = names[ident] if ident < len(names) else "id%d" % ident
+        tid, track = TRACKS.get(name, (1, "Application"))
+        seen[tid] = track
+        item = {"name": name, "ts": stamp, "pid": 1, "tid": tid}
+        if event == EVENT_ENTER:
+            item["ph"] = "B"
+            if data:
+                item["args"] = decode(name, data)
+        elif event == EVENT_EXIT:
+            item["ph"] = "E"
+        else:
+            item["ph"] = "i"
+            item["s"] = "t"
+            item["args"] = decode(name, data)
+        events.append(item)
+    for tid, track in seen.items():
+        events.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": tid, "args": {"name": track}})
+    events.append({"name": "process_name", "ph": "M", "pid": 1, "args": {"name": "Peco10"}})
+    return {"traceEvents": events, "displayTimeUnit": "ms"}
+
+
+def main():
+    if len(sys.argv) < 3:
+        sys.exit(__doc__)
+    records, names = load(sys.argv[1])
+    with open(sys.argv[2], "w") as out:
+        json.dump(export(records, names), out, indent=1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+"""Turn a Peco10 trace dump (see Include/Trace.h) into a per-function time table.
+
+Accepted inputs:
+  * text produced by Trace_Dump()            ("N,..." and "R,..." lines)
+  * raw memory image of Trace_Buffer         (*.bin, little endian)
+  * Intel HEX saved by the uVision debugger  (*.hex), e.g.
+        SAVE trace.hex &Trace_Buffer, ((char*)&Trace_Buffer) + sizeof(Trace_Buffer)
+
+Usage: trace_table.py <dump> [names.txt]
+"""
+import struct
+import sys
+
+TRACE_MAGIC = 0x31435254
+DEFAULT_NAMES = [
+    "IC_74hc595",
+    "IC_74hc595_Transaction",
+    "Lcd_Frame_Transfer",
+    "Lcd_Segment_Display_App",
+    "Keypad_Scan",
+    "Config_Switch_Get_Value",
+    "lcd_enable",
+    "Lcd_Put_Char",
+    "595_Latch",
+    "SPI_Transfer",
+    "LCD_SCE",
+    "Busy_Wait",
+    "Keypad_Row",
+    "HD44780_Command",
+    "Boot_Milestone",
+    "Event",
+]
+EVENT_ENTER = 0
+EVENT_EXIT = 1
+EVENT_INSTANT = 2
+EVENT_CODE = {"E": EVENT_ENTER, "X": EVENT_EXIT, "I": EVENT_INSTANT}
+
+
+def parse_ihex(path):
+    data = {}
+    base = 0
+    for line in open(path):
+        line = line.strip()
+        if not line.startswith(":"):
+            continue
+        raw = bytes.fromhex(line[1:])
+        count, addr, kind = raw[0], (raw[1] << 8) | raw[2], raw[3]
+        payload = raw[4:4 + count]
+        if kind == 0:
+            for i, b in enumerate(payload):
+                data[base + addr + i] = b
+        elif kind == 4:
+            base = ((payload[0] << 8) | payload[1]) << 16
+    start = min(data)
+    return bytes(data.get(a, 0) for a in range(start, max(data) + 1))
+
+
+def parse_image(blob):
+    magic, size, head = struct.unpack_from("<III", blob, 0)
+    if magic != TRACE_MAGIC:
+        sys.exit("not a trace buffer (bad magic 0x%08X)" % magic)
+    count = min(head, size)
+    records = []
+    for i in range(head - count, head):
+        off = 12 + (i & (size - 1)) * 8
+        records.append(struct.unpack_from("<IBBH", blob, off))
+    return records, list(DEFAULT_NAMES)
+
+
+def parse_text(path):
+    names = list(DEFAULT_NAMES)
+    records = []
+    for line in open(path):
+        field = line.strip().split(",")
+        if field[0] == "N":
+            idx = int(field[1])
+            while len(names) <= idx:
+                names.append("id%d" % len(names))
+            names[idx] = field[2]
+        elif field[0] == "R":
+            records.append((int(field[1]), int(field[2]), EVENT_CODE[field[3]], int(field[4])))
+    return records, names
+
+
+def load(path):
+    if path.endswith(".bin"):
+        return parse_image(open(path, "rb").read())
+    if path.endswith(".hex"):
+        return parse_image(parse_ihex(path))
+    return parse_text(path)
+
+
+def table(records, names):
+    stats = {}
+    stack = {}
+    for stamp, ident, event, _ in records:
+        if event == EVENT_ENTER:
+            stack.setdefault(ident, []).append(stamp)
+        elif event == EVENT_EXIT and stack.get(ident):
+            # TIM2 wraps every 2^32 us
+            span = (stamp - stack[ident].pop()) & 0xFFFFFFFF
+            calls, total, worst = stats.get(ident, (0, 0, 0))
+            stats[ident] = (calls + 1, total + span, max(worst, span))
+    if records:
+        window = (records[-1][0] - records[0][0]) & 0xFFFFFFFF
+    else:
+        window = 0
+    print("%-26s %8s %10s %9s %9s %7s" % ("function", "calls", "total us", "avg us", "max us", "% win"))
+    for ident, (calls, total, worst) in sorted(stats.items(), key=lambda kv: -kv[1][1]):
+        name = names[ident] if ident < len(names) else "id%d" % ident
+        share = (100.0 * total / window) if window else 0.0
+        print("%-26s %8d %10d %9.1f %9d %7.1f" % (name, calls, total, total / calls, worst, share))
+    print("window: %d us, %d records" % (window, len(records)))
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit(__doc__)
+    records, names = load(sys.argv[1])
+    table(records, names)
+
+
+if __name__ == "__main__":
+    main()